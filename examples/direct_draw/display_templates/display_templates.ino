@@ -0,0 +1,73 @@
+/*
+    MIT License
+
+    Copyright (c) 2016-2018, Alexey Dynda
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+/**
+ *   Nano/Atmega328 PINS: connect LCD to D5 (D/C), D4 (CS), D3 (RES), D11(DIN), D13(CLK)
+ *   Attiny SPI PINS:     connect LCD to D4 (D/C), GND (CS), D3 (RES), D1(DIN), D2(CLK)
+ *   ESP8266: connect LCD to D1(D/C), D2(CS), RX(RES), D7(DIN), D5(CLK)
+ */
+
+/*
+ * The demo draws frames via Display template, which has ssd1306 controller and
+ * bus selected at compile time. Text is printed via usual C API on top of the frame.
+ */
+
+#include "ssd1306.h"
+#include "ssd1306_display.h"
+
+#if defined(CONFIG_AVR_SPI_AVAILABLE) && defined(CONFIG_AVR_SPI_ENABLE)
+typedef Display<DriverSsd1306, IntfAvrSpi> Oled;
+#elif defined(ARDUINO) && defined(CONFIG_PLATFORM_SPI_AVAILABLE) && defined(CONFIG_PLATFORM_SPI_ENABLE)
+typedef Display<DriverSsd1306, IntfArduinoSpi> Oled;
+#else
+typedef Display<DriverSsd1306, IntfRuntime> Oled;
+#endif
+
+static uint8_t buffer[128 * 64 / 8];
+static uint8_t phase = 0;
+
+void setup()
+{
+    ssd1306_128x64_spi_init(3, 4, 5); // 3 RST, 4 CES, 5 DS
+    ssd1306_setFixedFont(ssd1306xled_font6x8);
+    Oled::fillScreen(0x00);
+}
+
+void loop()
+{
+    /* Diagonal stripes, moving to the right */
+    for (uint16_t i = 0; i < sizeof(buffer); i++)
+    {
+        uint8_t d = (i & 0x7F) + ((i >> 7) << 3) - phase;
+        uint8_t data = 0;
+        for (uint8_t bit = 0; bit < 8; bit++)
+        {
+            if ( (d + bit) & 0x08 ) data |= (1 << bit);
+        }
+        buffer[i] = data;
+    }
+    Oled::drawBuffer(0, 0, 128, 64, buffer);
+    ssd1306_printFixed(40, 24, " Display ", STYLE_BOLD);
+    phase++;
+    delay(40);
+}
@@ -24,7 +24,9 @@
 
 #include "ssd1306_interface.h"
 #include "spi/ssd1306_spi.h"
+#include "lcd/lcd_common.h"
 #include <stddef.h>
+#include <string.h>
 
 static void ssd1306_send_buffer_generic(const uint8_t* buffer, uint16_t size);
 
@@ -66,3 +68,150 @@ void ssd1306_send_buffer_generic(const uint8_t* buffer, uint16_t size)
         buffer++;
     }
 }
+
+#ifdef CONFIG_SSD1306_INTERFACE_STATS_ENABLE
+
+#if defined(__AVR__) && !defined(ARDUINO)
+#define stats_micros()  (0)
+#else
+#define stats_micros()  micros()
+#endif
+
+static ssd1306_interface_t s_statsIntf;
+static ssd1306_interface_stats_t s_stats;
+static uint8_t s_statsEnabled = 0;
+/* Current D/C level: 0 - command, 1 - data */
+static uint8_t s_statsDc = 0;
+/* Set while the first byte of i2c transaction (control byte) is expected */
+static uint8_t s_statsControl = 0;
+/* Set while original send_buffer() is in progress, it can call ssd1306_intf.send() */
+static uint8_t s_statsInBuffer = 0;
+static uint32_t s_statsStartTime;
+
+static void stats_count(const uint8_t *data, uint16_t size)
+{
+    s_stats.bytes += size;
+    if (!s_statsIntf.spi && s_statsControl)
+    {
+        /* i2c control byte: 0x00 - commands follow, 0x40 - data follow */
+        s_statsControl = 0;
+        s_statsDc = (data[0] & 0x40) ? 1 : 0;
+        size--;
+    }
+    if (s_statsDc)
+        s_stats.dataBytes += size;
+    else
+        s_stats.commandBytes += size;
+}
+
+static void stats_start(void)
+{
+    s_stats.transactions++;
+    s_statsControl = 1;
+    s_statsStartTime = stats_micros();
+    s_statsIntf.start();
+}
+
+static void stats_stop(void)
+{
+    s_statsIntf.stop();
+    uint32_t duration = (uint32_t)(stats_micros() - s_statsStartTime);
+    s_stats.time += duration;
+    if (duration > s_stats.maxTime)
+    {
+        s_stats.maxTime = duration;
+    }
+}
+
+static void stats_send(uint8_t data)
+{
+    if (!s_statsInBuffer)
+    {
+        stats_count(&data, 1);
+    }
+    s_statsIntf.send(data);
+}
+
+static void stats_send_buffer(const uint8_t *buffer, uint16_t size)
+{
+    if (size)
+    {
+        stats_count(buffer, size);
+    }
+    s_statsInBuffer = 1;
+    s_statsIntf.send_buffer(buffer, size);
+    s_statsInBuffer = 0;
+}
+
+static void stats_close(void)
+{
+    ssd1306_intfStatsDisable();
+    ssd1306_intf.close();
+}
+
+/* Display drivers copy interface pointers to ssd1306_lcd during initialization, *
+ * so pixel callbacks, equal to the replaced functions, are redirected as well.  */
+static void stats_redirect(void (*from)(uint8_t), void (*to)(uint8_t),
+                           void (*fromBuffer)(const uint8_t *, uint16_t),
+                           void (*toBuffer)(const uint8_t *, uint16_t))
+{
+    if (ssd1306_lcd.send_pixels1 == from) ssd1306_lcd.send_pixels1 = to;
+    if (ssd1306_lcd.send_pixels8 == from) ssd1306_lcd.send_pixels8 = to;
+    if (ssd1306_lcd.send_pixels_buffer1 == fromBuffer) ssd1306_lcd.send_pixels_buffer1 = toBuffer;
+    if (ssd1306_lcd.send_pixels_buffer8 == fromBuffer) ssd1306_lcd.send_pixels_buffer8 = toBuffer;
+    if (ssd1306_lcd.send_pixels_buffer16 == fromBuffer) ssd1306_lcd.send_pixels_buffer16 = toBuffer;
+}
+
+void ssd1306_intfStatsEnable(void)
+{
+    if (s_statsEnabled)
+    {
+        return;
+    }
+    s_statsIntf = ssd1306_intf;
+    ssd1306_intf.start = stats_start;
+    ssd1306_intf.stop = stats_stop;
+    ssd1306_intf.send = stats_send;
+    ssd1306_intf.send_buffer = stats_send_buffer;
+    ssd1306_intf.close = stats_close;
+    stats_redirect(s_statsIntf.send, stats_send, s_statsIntf.send_buffer, stats_send_buffer);
+    s_statsEnabled = 1;
+    ssd1306_intfStatsReset();
+}
+
+void ssd1306_intfStatsDisable(void)
+{
+    if (!s_statsEnabled)
+    {
+        return;
+    }
+    ssd1306_intf.start = s_statsIntf.start;
+    ssd1306_intf.stop = s_statsIntf.stop;
+    ssd1306_intf.send = s_statsIntf.send;
+    ssd1306_intf.send_buffer = s_statsIntf.send_buffer;
+    ssd1306_intf.close = s_statsIntf.close;
+    stats_redirect(stats_send, s_statsIntf.send, stats_send_buffer, s_statsIntf.send_buffer);
+    s_statsEnabled = 0;
+}
+
+void ssd1306_intfStatsReset(void)
+{
+    memset(&s_stats, 0, sizeof(s_stats));
+}
+
+void ssd1306_intfStatsGet(ssd1306_interface_stats_t *stats)
+{
+    *stats = s_stats;
+}
+
+void ssd1306_intfStatsDataMode(uint8_t mode)
+{
+    mode = mode ? 1 : 0;
+    if (s_statsEnabled && (mode != s_statsDc))
+    {
+        s_stats.dcSwitches++;
+    }
+    s_statsDc = mode;
+}
+
+#endif
@@ -140,6 +140,63 @@ void ssd1306_commandStart(void);
  */
 void ssd1306_dataStart(void);
 
+#ifdef CONFIG_SSD1306_INTERFACE_STATS_ENABLE
+
+/** Bus traffic counters, collected by interface instrumentation */
+typedef struct
+{
+    /** Total number of bytes sent, including i2c control bytes */
+    uint32_t bytes;
+    /** Number of bytes sent in command mode */
+    uint32_t commandBytes;
+    /** Number of bytes sent in data mode */
+    uint32_t dataBytes;
+    /** Number of start()/stop() pairs */
+    uint32_t transactions;
+    /** Number of D/C line level changes (spi only) */
+    uint32_t dcSwitches;
+    /** Total time spent in transactions, in microseconds */
+    uint32_t time;
+    /** The longest transaction time, in microseconds */
+    uint32_t maxTime;
+} ssd1306_interface_stats_t;
+
+/**
+ * @brief Enables bus traffic instrumentation.
+ *
+ * Wraps functions of currently initialized ssd1306_intf with counting functions.
+ * Pixel callbacks of ssd1306_lcd, copied from ssd1306_intf by display driver, are
+ * wrapped too.
+ * Call this function after display initialization. Counters are reset.
+ * @note CONFIG_SSD1306_INTERFACE_STATS_ENABLE must be defined in UserSettings.h.
+ *       Transaction times are not collected on plain AVR (non-Arduino) builds.
+ */
+void ssd1306_intfStatsEnable(void);
+
+/**
+ * Removes instrumentation wrappers from ssd1306_intf.
+ */
+void ssd1306_intfStatsDisable(void);
+
+/**
+ * Resets bus traffic counters, for example, before drawing new frame.
+ */
+void ssd1306_intfStatsReset(void);
+
+/**
+ * Returns bus traffic counters, collected since the last reset.
+ * @param stats - pointer to structure to fill
+ */
+void ssd1306_intfStatsGet(ssd1306_interface_stats_t *stats);
+
+/**
+ * Informs instrumentation about D/C line level. Called by spi module.
+ * @param mode - 0 for command mode, 1 for data mode
+ */
+void ssd1306_intfStatsDataMode(uint8_t mode);
+
+#endif
+
 /**
  * @}
  */
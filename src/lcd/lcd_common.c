@@ -25,13 +25,34 @@
 #include "lcd/lcd_common.h"
 #include "intf/ssd1306_interface.h"
 #include "intf/spi/ssd1306_spi.h"
+#include "ssd1306_convert.h"
 #include <stddef.h>
 
 #define CMD_ARG 0xFF
 #define CMD_DELAY 0xFF
 
+/* Number of pixels, converted at once by bulk pixel conversion functions */
+#define PIXELS_CHUNK_SIZE  16
+
+#ifndef CONFIG_SSD1306_MONO16_CHUNK_SIZE
+/* Stack buffer for monochrome pixels, expanded to RGB16: 16 bytes per each source byte */
+#if defined(__AVR__)
+#define CONFIG_SSD1306_MONO16_CHUNK_SIZE  32
+#else
+#define CONFIG_SSD1306_MONO16_CHUNK_SIZE  256
+#endif
+#endif
+
 ssd1306_lcd_t ssd1306_lcd = { 0 };
 
+extern uint16_t ssd1306_color;
+
+/* RGB16 pixels for each nibble value: 4 pixels, lsb first, high byte of pixel first */
+static uint8_t s_monoTable[16][8];
+static uint16_t s_monoColor;
+static uint16_t s_monoBgColor;
+static uint8_t s_monoTableValid = 0;
+
 void ssd1306_sendData(uint8_t data)
 {
     ssd1306_dataStart();
@@ -39,6 +60,88 @@ void ssd1306_sendData(uint8_t data)
     ssd1306_intf.stop();
 }
 
+void ssd1306_sendPixelsBuffer8To16(const uint8_t *buffer, uint16_t len)
+{
+    uint8_t chunk[PIXELS_CHUNK_SIZE * 2];
+    while (len)
+    {
+        uint8_t n = len < PIXELS_CHUNK_SIZE ? len : PIXELS_CHUNK_SIZE;
+        ssd1306_convertRgb8ToRgb16(chunk, buffer, n);
+        ssd1306_intf.send_buffer(chunk, n * 2);
+        buffer += n;
+        len -= n;
+    }
+}
+
+void ssd1306_sendPixelsBuffer16To8(const uint8_t *buffer, uint16_t len)
+{
+    uint8_t chunk[PIXELS_CHUNK_SIZE];
+    len >>= 1;
+    while (len)
+    {
+        uint8_t n = len < PIXELS_CHUNK_SIZE ? len : PIXELS_CHUNK_SIZE;
+        ssd1306_convertRgb16ToRgb8(chunk, buffer, n);
+        ssd1306_intf.send_buffer(chunk, n);
+        buffer += n * 2;
+        len -= n;
+    }
+}
+
+void ssd1306_setMonoColors16(uint16_t color, uint16_t bgColor)
+{
+    if ( s_monoTableValid && (s_monoColor == color) && (s_monoBgColor == bgColor) )
+    {
+        return;
+    }
+    for (uint8_t n = 0; n < 16; n++)
+    {
+        for (uint8_t i = 0; i < 4; i++)
+        {
+            uint16_t c = (n & (1 << i)) ? color : bgColor;
+            s_monoTable[n][2*i] = c >> 8;
+            s_monoTable[n][2*i + 1] = c & 0xFF;
+        }
+    }
+    s_monoColor = color;
+    s_monoBgColor = bgColor;
+    s_monoTableValid = 1;
+}
+
+void ssd1306_expandMonoPixels16(uint8_t data, uint8_t *dst)
+{
+    memcpy( dst, s_monoTable[data & 0x0F], 8 );
+    memcpy( dst + 8, s_monoTable[data >> 4], 8 );
+}
+
+void ssd1306_sendMonoPixels16(const uint8_t *buffer, uint16_t len)
+{
+    uint8_t chunk[CONFIG_SSD1306_MONO16_CHUNK_SIZE];
+    ssd1306_setMonoColors16( ssd1306_color, 0x0000 );
+    while (len)
+    {
+        uint8_t n = len < (sizeof(chunk) >> 4) ? len : (sizeof(chunk) >> 4);
+        for (uint8_t i = 0; i < n; i++)
+        {
+            ssd1306_expandMonoPixels16( buffer[i], &chunk[i << 4] );
+        }
+        ssd1306_intf.send_buffer( chunk, n << 4 );
+        buffer += n;
+        len -= n;
+    }
+}
+
+void ssd1306_expandMonoPixels4(uint8_t left, uint8_t right, uint8_t color, uint8_t *dst)
+{
+    color &= 0x0F;
+    uint8_t table[4] = { 0x00, color, (uint8_t)(color << 4), (uint8_t)(color | (color << 4)) };
+    for (uint8_t i = 0; i < 8; i++)
+    {
+        dst[i] = table[(left & 0x01) | ((right & 0x01) << 1)];
+        left >>= 1;
+        right >>= 1;
+    }
+}
+
 void ssd1306_configureI2cDisplay(const uint8_t *config, uint8_t configSize)
 {
     ssd1306_commandStart();
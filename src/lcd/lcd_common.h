@@ -148,6 +148,25 @@ typedef struct
      */
     void (*send_pixels16)(uint16_t data);
 
+    /**
+     * @brief Sends buffer containing RGB pixels encoded in 3-3-2 format to OLED driver.
+     * Sends buffer containing RGB pixels encoded in 3-3-2 format to OLED driver.
+     * Can be NULL, then the library sends pixels one by one via send_pixels8().
+     * @param buffer - buffer containing RGB8 pixels.
+     * @param len - length of buffer in bytes (number of pixels).
+     */
+    void (*send_pixels_buffer8)(const uint8_t *buffer, uint16_t len);
+
+    /**
+     * @brief Sends buffer containing RGB pixels encoded in 5-6-5 format to OLED driver.
+     * Sends buffer containing RGB pixels encoded in 5-6-5 format to OLED driver.
+     * Each pixel takes 2 bytes, high byte goes first.
+     * Can be NULL, then the library sends pixels one by one via send_pixels16().
+     * @param buffer - buffer containing RGB16 pixels.
+     * @param len - length of buffer in bytes (twice number of pixels).
+     */
+    void (*send_pixels_buffer16)(const uint8_t *buffer, uint16_t len);
+
     /**
      * @brief Sets library display mode for direct draw functions.
      *
@@ -162,6 +181,35 @@ typedef struct
      * @see lcd_mode_t
      */
     void (*set_mode)(lcd_mode_t mode);
+
+    /**
+     * @brief Fills rectangle using graphic acceleration of display controller.
+     *
+     * Optional callback, can be NULL. RGB direct draw functions call it before
+     * sending pixels. If the controller cannot perform operation in current mode
+     * (or sending pixels is cheaper), the callback returns 0, and the library
+     * falls back to sending pixels.
+     * @param x1 left position in pixels
+     * @param y1 top position in pixels
+     * @param x2 right position in pixels, x2 >= x1
+     * @param y2 bottom position in pixels, y2 >= y1
+     * @param color RGB16 color to fill rectangle with
+     * @return 1 if rectangle is filled by the controller, 0 otherwise
+     */
+    uint8_t (*fill_rect)(lcdint_t x1, lcdint_t y1, lcdint_t x2, lcdint_t y2, uint16_t color);
+
+    /**
+     * @brief Draws line using graphic acceleration of display controller.
+     *
+     * Optional callback, can be NULL. Works the same way as fill_rect().
+     * @param x1 x position of start point in pixels
+     * @param y1 y position of start point in pixels
+     * @param x2 x position of end point in pixels
+     * @param y2 y position of end point in pixels
+     * @param color RGB16 color of the line
+     * @return 1 if line is drawn by the controller, 0 otherwise
+     */
+    uint8_t (*draw_line)(lcdint_t x1, lcdint_t y1, lcdint_t x2, lcdint_t y2, uint16_t color);
 } ssd1306_lcd_t;
 
 /**
@@ -246,6 +294,64 @@ void         ssd1306_sendData(uint8_t data) __attribute__ ((deprecated));
  */
 #define ssd1306_sendPixel8        ssd1306_lcd.send_pixels8
 
+/**
+ * Sends buffer of RGB8 pixels to display controller, working in 16-bit color mode.
+ * Pixels are converted to RGB16 by small chunks, which are passed to ssd1306_intf.send_buffer().
+ * Color drivers use this function as send_pixels_buffer8() implementation.
+ * @param buffer - buffer containing RGB8 pixels.
+ * @param len - length of buffer in bytes (number of pixels).
+ */
+void ssd1306_sendPixelsBuffer8To16(const uint8_t *buffer, uint16_t len);
+
+/**
+ * Sends buffer of RGB16 pixels to display controller, working in 8-bit color mode.
+ * Pixels are converted to RGB8 by small chunks, which are passed to ssd1306_intf.send_buffer().
+ * Color drivers use this function as send_pixels_buffer16() implementation.
+ * @param buffer - buffer containing RGB16 pixels, high byte first.
+ * @param len - length of buffer in bytes (twice number of pixels).
+ */
+void ssd1306_sendPixelsBuffer16To8(const uint8_t *buffer, uint16_t len);
+
+/**
+ * @brief Sets colors for expanding monochrome pixels to RGB16 format.
+ *
+ * Sets colors for expanding monochrome pixels to RGB16 format. The function rebuilds
+ * 128-byte lookup table of pre-packed RGB16 pixels for each 4-bit value, if colors are changed.
+ * @param color RGB16 color for set bits
+ * @param bgColor RGB16 color for cleared bits
+ */
+void ssd1306_setMonoColors16(uint16_t color, uint16_t bgColor);
+
+/**
+ * Expands byte of 8 monochrome pixels (least significant bit goes first) to 16 bytes of
+ * RGB16 pixels (high byte of each pixel first) using lookup table.
+ * @param data 8 monochrome pixels
+ * @param dst destination buffer of at least 16 bytes
+ * @see ssd1306_setMonoColors16()
+ */
+void ssd1306_expandMonoPixels16(uint8_t data, uint8_t *dst);
+
+/**
+ * Sends buffer of monochrome pixels to display controller, working in 16-bit color mode.
+ * Set bits are sent in ssd1306_color, cleared bits are sent black. Pixels are expanded by
+ * chunks of CONFIG_SSD1306_MONO16_CHUNK_SIZE bytes, which are passed to ssd1306_intf.send_buffer(). Color drivers use
+ * this function as send_pixels_buffer1() implementation.
+ * @param buffer - buffer containing monochrome pixels.
+ * @param len - length of buffer in bytes.
+ */
+void ssd1306_sendMonoPixels16(const uint8_t *buffer, uint16_t len);
+
+/**
+ * Expands 2 bytes of monochrome pixels (2 adjacent columns, 8 pixels each, least significant
+ * bit goes first) to 8 bytes of 4-bit grayscale pixels, 2 pixels per byte, left column in low
+ * nibble. This is the format of grayscale controllers in vertical increment mode.
+ * @param left 8 monochrome pixels of left column
+ * @param right 8 monochrome pixels of right column
+ * @param color 4-bit grayscale color for set bits, cleared bits are black
+ * @param dst destination buffer of at least 8 bytes
+ */
+void ssd1306_expandMonoPixels4(uint8_t left, uint8_t right, uint8_t color, uint8_t *dst);
+
 /**
  * @brief Sends configuration being passed to lcd display i2c/spi controller.
  *
@@ -420,31 +526,13 @@ void ssd1306_resetController(int8_t rstPin, uint8_t delayMs);
  * when working in ssd1306 compatible mode.
  */
 #define SSD1306_COMPAT_SEND_PIXELS_RGB16_CMDS() \
-    extern uint16_t ssd1306_color; \
     static void send_pixels_compat16(uint8_t data) \
     { \
-        for (uint8_t i=8; i>0; i--) \
-        { \
-            if ( data & 0x01 ) \
-            { \
-                ssd1306_intf.send( (uint8_t)(ssd1306_color >> 8 ) ); \
-                ssd1306_intf.send( (uint8_t)(ssd1306_color & 0xFF) ); \
-            } \
-            else \
-            { \
-                ssd1306_intf.send( 0B00000000 ); \
-                ssd1306_intf.send( 0B00000000 ); \
-            } \
-            data >>= 1; \
-        } \
+        ssd1306_sendMonoPixels16(&data, 1); \
     } \
     static void send_pixels_buffer_compat16(const uint8_t *buffer, uint16_t len) \
     { \
-        while(len--) \
-        { \
-            send_pixels_compat16(*buffer); \
-            buffer++; \
-        } \
+        ssd1306_sendMonoPixels16(buffer, len); \
     }
 
 
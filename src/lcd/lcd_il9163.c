@@ -35,7 +35,6 @@
 #define CMD_ARG     0xFF
 #define CMD_DELAY   0xFF
 
-extern uint16_t ssd1306_color;
 extern uint32_t s_ssd1306_spi_clock;
 
 static uint8_t s_rotation = 0x00;
@@ -212,29 +211,7 @@ void    il9163_setMode(lcd_mode_t mode)
 
 static void il9163_sendPixels(uint8_t data)
 {
-    for (uint8_t i=8; i>0; i--)
-    {
-        if ( data & 0x01 )
-        {
-            ssd1306_intf.send( (uint8_t)(ssd1306_color>>8) );
-            ssd1306_intf.send( (uint8_t)(ssd1306_color) );
-        }
-        else
-        {
-            ssd1306_intf.send( 0B00000000 );
-            ssd1306_intf.send( 0B00000000 );
-        }
-        data >>= 1;
-    }
-}
-
-static void il9163_sendPixelsBuffer(const uint8_t *buffer, uint16_t len)
-{
-    while(len--)
-    {
-        il9163_sendPixels(*buffer);
-        buffer++;
-    }
+    ssd1306_sendMonoPixels16(&data, 1);
 }
 
 static void il9163_sendPixel8(uint8_t data)
@@ -259,9 +236,11 @@ void    il9163_128x128_init()
     ssd1306_lcd.set_block = il9163_setBlock;
     ssd1306_lcd.next_page = il9163_nextPage;
     ssd1306_lcd.send_pixels1  = il9163_sendPixels;
-    ssd1306_lcd.send_pixels_buffer1 = il9163_sendPixelsBuffer;
+    ssd1306_lcd.send_pixels_buffer1 = ssd1306_sendMonoPixels16;
     ssd1306_lcd.send_pixels8 = il9163_sendPixel8;
     ssd1306_lcd.send_pixels16 = il9163_sendPixel16;
+    ssd1306_lcd.send_pixels_buffer8 = ssd1306_sendPixelsBuffer8To16;
+    ssd1306_lcd.send_pixels_buffer16 = ssd1306_intf.send_buffer;
     ssd1306_lcd.set_mode = il9163_setMode;
     ssd1306_configureSpiDisplay(s_oled128x128_initData, sizeof(s_oled128x128_initData));
 }
@@ -412,9 +391,11 @@ void    st7735_128x160_init()
     ssd1306_lcd.set_block = st7735_setBlock;
     ssd1306_lcd.next_page = il9163_nextPage;
     ssd1306_lcd.send_pixels1  = il9163_sendPixels;
-    ssd1306_lcd.send_pixels_buffer1 = il9163_sendPixelsBuffer;
+    ssd1306_lcd.send_pixels_buffer1 = ssd1306_sendMonoPixels16;
     ssd1306_lcd.send_pixels8 = il9163_sendPixel8;
     ssd1306_lcd.send_pixels16 = il9163_sendPixel16;
+    ssd1306_lcd.send_pixels_buffer8 = ssd1306_sendPixelsBuffer8To16;
+    ssd1306_lcd.send_pixels_buffer16 = ssd1306_intf.send_buffer;
     ssd1306_lcd.set_mode = st7735_setMode;
     ssd1306_configureSpiDisplay2(s_oled128x160_initData, sizeof(s_oled128x160_initData));
 }
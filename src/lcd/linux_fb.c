@@ -0,0 +1,416 @@
+/*
+    MIT License
+
+    Copyright (c) 2019, Alexey Dynda
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include "linux_fb.h"
+#include "lcd_common.h"
+#include "intf/ssd1306_interface.h"
+#include "nano_gfx_types.h"
+
+#if defined(__linux__) && !defined(ARDUINO) && !defined(__KERNEL__)
+
+#include <stdio.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <linux/fb.h>
+
+extern uint16_t ssd1306_color;
+
+typedef enum
+{
+    FB_FORMAT_GENERIC,
+    FB_FORMAT_RGB565,
+    FB_FORMAT_XRGB8888,
+} fb_format_t;
+
+static int s_fb_fd = -1;
+static uint8_t *s_fb_mem = NULL;
+static size_t s_fb_memSize = 0;
+/* First visible pixel of the framebuffer (takes into account x/y offsets) */
+static uint8_t *s_fb_origin = NULL;
+static uint32_t s_fb_lineLength = 0;
+static uint8_t s_fb_bytesPerPixel = 0;
+static fb_format_t s_fb_format = FB_FORMAT_GENERIC;
+static struct fb_bitfield s_fb_red;
+static struct fb_bitfield s_fb_green;
+static struct fb_bitfield s_fb_blue;
+
+/* Input pixel depth: 8 for RGB332, 16 for RGB565 */
+static uint8_t s_depth = 16;
+/* Block, set by set_block(), and current write position.
+ * In compatible mode s_y holds page number instead of pixel row */
+static lcduint_t s_x0;
+static lcduint_t s_x1;
+static lcduint_t s_x;
+static lcduint_t s_y;
+static uint8_t s_msb;
+static uint8_t s_msbReady = 0;
+
+static inline uint32_t fb_component(uint8_t value, const struct fb_bitfield *field)
+{
+    if (field->length >= 8)
+    {
+        return (uint32_t)value << (field->offset + field->length - 8);
+    }
+    return (uint32_t)(value >> (8 - field->length)) << field->offset;
+}
+
+static inline uint32_t fb_xrgb8888(uint16_t color)
+{
+    uint8_t r = (color >> 8) & 0xF8; r |= r >> 5;
+    uint8_t g = (color >> 3) & 0xFC; g |= g >> 6;
+    uint8_t b = (color << 3) & 0xF8; b |= b >> 5;
+    return ((uint32_t)r << 16) | ((uint32_t)g << 8) | b;
+}
+
+static void fb_put_pixel(lcduint_t x, lcduint_t y, uint16_t color)
+{
+    if ( (x >= ssd1306_lcd.width) || (y >= ssd1306_lcd.height) )
+    {
+        return;
+    }
+    uint8_t *dst = s_fb_origin + y * s_fb_lineLength + x * s_fb_bytesPerPixel;
+    if (s_fb_format == FB_FORMAT_RGB565)
+    {
+        *(uint16_t *)dst = color;
+        return;
+    }
+    if (s_fb_format == FB_FORMAT_XRGB8888)
+    {
+        *(uint32_t *)dst = fb_xrgb8888(color);
+        return;
+    }
+    /* Expand RGB565 to 8 bits per component */
+    uint8_t r = (color >> 8) & 0xF8; r |= r >> 5;
+    uint8_t g = (color >> 3) & 0xFC; g |= g >> 6;
+    uint8_t b = (color << 3) & 0xF8; b |= b >> 5;
+    uint32_t pixel = fb_component(r, &s_fb_red) |
+                     fb_component(g, &s_fb_green) |
+                     fb_component(b, &s_fb_blue);
+    switch (s_fb_bytesPerPixel)
+    {
+        case 1: dst[0] = pixel; break;
+        case 2: *(uint16_t *)dst = pixel; break;
+        case 3: dst[0] = pixel; dst[1] = pixel >> 8; dst[2] = pixel >> 16; break;
+        default: *(uint32_t *)dst = pixel; break;
+    }
+}
+
+static void fb_set_block(lcduint_t x, lcduint_t y, lcduint_t w)
+{
+    lcduint_t rx = w ? (x + w - 1) : (ssd1306_lcd.width - 1);
+    s_x0 = x;
+    s_x1 = rx < ssd1306_lcd.width ? rx : (ssd1306_lcd.width - 1);
+    s_x = x;
+    s_y = y;
+    s_msbReady = 0;
+}
+
+static void fb_next_page(void)
+{
+}
+
+static void fb_set_block_compat(lcduint_t x, lcduint_t y, lcduint_t w)
+{
+    fb_set_block(x, y, w);
+}
+
+static void fb_next_page_compat(void)
+{
+    fb_set_block_compat(s_x0, s_y + 1, 0);
+}
+
+static void fb_write_pixel(uint16_t color)
+{
+    fb_put_pixel(s_x, s_y, color);
+    if (++s_x > s_x1)
+    {
+        s_x = s_x0;
+        s_y++;
+    }
+}
+
+static void fb_send_pixels1(uint8_t data)
+{
+    uint16_t color = s_depth == 8 ? RGB8_TO_RGB16(ssd1306_color & 0xFF) : ssd1306_color;
+    lcduint_t y = s_y << 3;
+    for (uint8_t i=8; i>0; i--)
+    {
+        fb_put_pixel(s_x, y++, (data & 0x01) ? color : 0);
+        data >>= 1;
+    }
+    if (++s_x > s_x1)
+    {
+        s_x = s_x0;
+        s_y++;
+    }
+}
+
+static void fb_send_pixels_buffer1(const uint8_t *buffer, uint16_t len)
+{
+    while(len--)
+    {
+        fb_send_pixels1(*buffer);
+        buffer++;
+    }
+}
+
+static void fb_send_pixels8(uint8_t data)
+{
+    fb_write_pixel(RGB8_TO_RGB16(data));
+}
+
+static void fb_send_pixels16(uint16_t color)
+{
+    fb_write_pixel(color);
+}
+
+/* Writes n pixels to framebuffer memory of native format, starting at current position */
+static void fb_write_row(const uint8_t *buffer, lcduint_t n, uint8_t depth)
+{
+    uint8_t *dst = s_fb_origin + s_y * s_fb_lineLength + s_x * s_fb_bytesPerPixel;
+    if (s_fb_format == FB_FORMAT_RGB565)
+    {
+        uint16_t *pixel = (uint16_t *)dst;
+        if (depth == 8)
+        {
+            for (; n; n--, buffer++) *pixel++ = RGB8_TO_RGB16(buffer[0]);
+        }
+        else
+        {
+            for (; n; n--, buffer += 2) *pixel++ = ((uint16_t)buffer[0] << 8) | buffer[1];
+        }
+    }
+    else
+    {
+        uint32_t *pixel = (uint32_t *)dst;
+        if (depth == 8)
+        {
+            for (; n; n--, buffer++) *pixel++ = fb_xrgb8888(RGB8_TO_RGB16(buffer[0]));
+        }
+        else
+        {
+            for (; n; n--, buffer += 2) *pixel++ = fb_xrgb8888(((uint16_t)buffer[0] << 8) | buffer[1]);
+        }
+    }
+}
+
+static void fb_send_pixels_buffer(const uint8_t *buffer, uint16_t len, uint8_t depth)
+{
+    uint8_t size = depth >> 3;
+    uint16_t count = len / size;
+    while (count)
+    {
+        if ( (s_fb_format == FB_FORMAT_GENERIC) || (s_x > s_x1) || (s_y >= ssd1306_lcd.height) )
+        {
+            fb_write_pixel(depth == 8 ? RGB8_TO_RGB16(buffer[0]) : ((uint16_t)buffer[0] << 8) | buffer[1]);
+            buffer += size;
+            count--;
+            continue;
+        }
+        /* Send the rest of the block row at once */
+        lcduint_t n = s_x1 - s_x + 1;
+        if (n > count) n = count;
+        fb_write_row(buffer, n, depth);
+        buffer += n * size;
+        count -= n;
+        s_x += n;
+        if (s_x > s_x1)
+        {
+            s_x = s_x0;
+            s_y++;
+        }
+    }
+}
+
+static void fb_send_pixels_buffer8(const uint8_t *buffer, uint16_t len)
+{
+    fb_send_pixels_buffer(buffer, len, 8);
+}
+
+static void fb_send_pixels_buffer16(const uint8_t *buffer, uint16_t len)
+{
+    fb_send_pixels_buffer(buffer, len, 16);
+}
+
+static void fb_set_mode(lcd_mode_t mode)
+{
+    if (mode == LCD_MODE_SSD1306_COMPAT)
+    {
+        ssd1306_lcd.set_block = fb_set_block_compat;
+        ssd1306_lcd.next_page = fb_next_page_compat;
+    }
+    else if (mode == LCD_MODE_NORMAL)
+    {
+        ssd1306_lcd.set_block = fb_set_block;
+        ssd1306_lcd.next_page = fb_next_page;
+    }
+}
+
+static void fb_start(void)
+{
+}
+
+static void fb_stop(void)
+{
+}
+
+/* Raw pixel data, sent via ssd1306_intf, have the same format as data of RGB oled controllers */
+static void fb_send(uint8_t data)
+{
+    if (s_depth == 8)
+    {
+        fb_write_pixel(RGB8_TO_RGB16(data));
+    }
+    else if (!s_msbReady)
+    {
+        s_msb = data;
+        s_msbReady = 1;
+    }
+    else
+    {
+        fb_write_pixel(((uint16_t)s_msb << 8) | data);
+        s_msbReady = 0;
+    }
+}
+
+static void fb_send_buffer(const uint8_t *buffer, uint16_t size)
+{
+    while (size--)
+    {
+        fb_send(*buffer);
+        buffer++;
+    }
+}
+
+static void fb_close(void)
+{
+    if (s_fb_mem)
+    {
+        munmap(s_fb_mem, s_fb_memSize);
+        s_fb_mem = NULL;
+        s_fb_origin = NULL;
+    }
+    if (s_fb_fd >= 0)
+    {
+        close(s_fb_fd);
+        s_fb_fd = -1;
+    }
+}
+
+static int fb_open(int8_t fbId)
+{
+    char filename[20];
+    struct fb_var_screeninfo var;
+    struct fb_fix_screeninfo fix;
+
+    fb_close();
+    snprintf(filename, sizeof(filename), "/dev/fb%d", fbId < 0 ? 0 : fbId);
+    s_fb_fd = open(filename, O_RDWR);
+    if (s_fb_fd < 0)
+    {
+        fprintf(stderr, "Failed to open framebuffer device %s\n", filename);
+        return -1;
+    }
+    if ( (ioctl(s_fb_fd, FBIOGET_FSCREENINFO, &fix) < 0) ||
+         (ioctl(s_fb_fd, FBIOGET_VSCREENINFO, &var) < 0) )
+    {
+        fprintf(stderr, "Failed to get framebuffer %s info\n", filename);
+        fb_close();
+        return -1;
+    }
+    if ( (fix.type != FB_TYPE_PACKED_PIXELS) || (var.bits_per_pixel < 8) ||
+         (var.bits_per_pixel > 32) || (var.bits_per_pixel & 0x07) )
+    {
+        fprintf(stderr, "Unsupported framebuffer %s format: %d bpp\n", filename, var.bits_per_pixel);
+        fb_close();
+        return -1;
+    }
+    s_fb_memSize = fix.smem_len;
+    s_fb_mem = (uint8_t *)mmap(NULL, s_fb_memSize, PROT_READ | PROT_WRITE, MAP_SHARED, s_fb_fd, 0);
+    if (s_fb_mem == MAP_FAILED)
+    {
+        fprintf(stderr, "Failed to map framebuffer %s\n", filename);
+        s_fb_mem = NULL;
+        fb_close();
+        return -1;
+    }
+    s_fb_lineLength = fix.line_length;
+    s_fb_bytesPerPixel = var.bits_per_pixel >> 3;
+    s_fb_origin = s_fb_mem + var.yoffset * s_fb_lineLength + var.xoffset * s_fb_bytesPerPixel;
+    s_fb_red = var.red;
+    s_fb_green = var.green;
+    s_fb_blue = var.blue;
+    if ( s_fb_bytesPerPixel == 2 && var.red.offset == 11 && var.red.length == 5 &&
+         var.green.offset == 5 && var.green.length == 6 &&
+         var.blue.offset == 0 && var.blue.length == 5 )
+    {
+        s_fb_format = FB_FORMAT_RGB565;
+    }
+    else if ( s_fb_bytesPerPixel == 4 && var.red.offset == 16 && var.red.length == 8 &&
+              var.green.offset == 8 && var.green.length == 8 &&
+              var.blue.offset == 0 && var.blue.length == 8 )
+    {
+        s_fb_format = FB_FORMAT_XRGB8888;
+    }
+    else
+    {
+        s_fb_format = FB_FORMAT_GENERIC;
+    }
+    ssd1306_intf.spi = 0;
+    ssd1306_intf.start = fb_start;
+    ssd1306_intf.stop = fb_stop;
+    ssd1306_intf.send = fb_send;
+    ssd1306_intf.send_buffer = fb_send_buffer;
+    ssd1306_intf.close = fb_close;
+
+    ssd1306_lcd.type = LCD_TYPE_CUSTOM;
+    ssd1306_lcd.width = var.xres;
+    ssd1306_lcd.height = var.yres;
+    ssd1306_lcd.set_block = fb_set_block_compat;
+    ssd1306_lcd.next_page = fb_next_page_compat;
+    ssd1306_lcd.send_pixels1 = fb_send_pixels1;
+    ssd1306_lcd.send_pixels_buffer1 = fb_send_pixels_buffer1;
+    ssd1306_lcd.send_pixels8 = fb_send_pixels8;
+    ssd1306_lcd.send_pixels16 = fb_send_pixels16;
+    ssd1306_lcd.send_pixels_buffer8 = fb_send_pixels_buffer8;
+    ssd1306_lcd.send_pixels_buffer16 = fb_send_pixels_buffer16;
+    ssd1306_lcd.set_mode = fb_set_mode;
+    return 0;
+}
+
+int linux_fb_8bit_init(int8_t fbId)
+{
+    s_depth = 8;
+    return fb_open(fbId);
+}
+
+int linux_fb_16bit_init(int8_t fbId)
+{
+    s_depth = 16;
+    return fb_open(fbId);
+}
+
+#endif
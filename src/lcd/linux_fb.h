@@ -0,0 +1,85 @@
+/*
+    MIT License
+
+    Copyright (c) 2019, Alexey Dynda
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+/**
+ * @file linux_fb.h Linux framebuffer (/dev/fbN) output driver
+ */
+
+#ifndef _SSD1306_LINUX_FB_H_
+#define _SSD1306_LINUX_FB_H_
+
+#include "ssd1306_hal/io.h"
+#include "lcd/lcd_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(__linux__) && !defined(ARDUINO) && !defined(__KERNEL__)
+
+/**
+ * @ingroup LCD_INTERFACE_API
+ * @{
+ */
+
+/**
+ * @brief Inits Linux framebuffer as 8-bit RGB display.
+ *
+ * Opens /dev/fbN device and maps its memory to the process. Display width and height
+ * are taken from framebuffer resolution. 8-bit RGB (RRRGGGBB) pixels, sent by
+ * ssd1306 8-bit functions and NanoCanvas8, are converted to framebuffer pixel format
+ * and written directly to mapped memory. The driver provides its own ssd1306_intf,
+ * so there is no need to init i2c or spi interface prior to calling this function.
+ * Use ssd1306_intf.close() to unmap framebuffer.
+ *
+ * @param fbId framebuffer device number (N in /dev/fbN), -1 for default /dev/fb0
+ * @return 0 on success, -1 if framebuffer cannot be opened or mapped
+ */
+int linux_fb_8bit_init(int8_t fbId);
+
+/**
+ * @brief Inits Linux framebuffer as 16-bit RGB display.
+ *
+ * Opens /dev/fbN device and maps its memory to the process. Display width and height
+ * are taken from framebuffer resolution. 16-bit RGB (RGB565) pixels, sent by
+ * ssd1306 16-bit functions and NanoCanvas16, are converted to framebuffer pixel format
+ * and written directly to mapped memory. The driver provides its own ssd1306_intf,
+ * so there is no need to init i2c or spi interface prior to calling this function.
+ * Use ssd1306_intf.close() to unmap framebuffer.
+ *
+ * @param fbId framebuffer device number (N in /dev/fbN), -1 for default /dev/fb0
+ * @return 0 on success, -1 if framebuffer cannot be opened or mapped
+ */
+int linux_fb_16bit_init(int8_t fbId);
+
+/**
+ * @}
+ */
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -94,34 +94,41 @@ static void next_page_compat(void)
     set_block_compat(__s_column,__s_page + 1, __s_w);
 }
 
-static void ssd1325_sendPixels(uint8_t data)
+
+static void ssd1325_sendPixelsBuffer(const uint8_t *buffer, uint16_t len)
 {
-    if (!(__s_pos & 0x01))
-    {
-        __s_leftPixel = data;
-        data = 0x00;
-    }
-    if ((__s_pos & 0x01) || (__s_pos == __s_column + __s_w2 - 1))
+    uint8_t chunk[32];
+    uint8_t n = 0;
+    while (len--)
     {
-        for (uint8_t i=8; i>0; i--)
+        uint8_t data = *buffer++;
+        if (!(__s_pos & 0x01))
+        {
+            __s_leftPixel = data;
+            data = 0x00;
+        }
+        if ((__s_pos & 0x01) || (__s_pos == __s_column + __s_w2 - 1))
         {
-            uint8_t color = (__s_leftPixel & 0x01) ? (ssd1306_color & 0x0F) : 0;
-            color |= (((data & 0x01) ? (ssd1306_color & 0x0F): 0) << 4);
-            ssd1306_intf.send(color);
-            data >>= 1;
-            __s_leftPixel >>= 1;
+            // Each 2 columns are packed to 8 bytes: 2 pixels per byte
+            ssd1306_expandMonoPixels4( __s_leftPixel, data, ssd1306_color, &chunk[n] );
+            n += 8;
+            if ( n == sizeof(chunk) )
+            {
+                ssd1306_intf.send_buffer( chunk, n );
+                n = 0;
+            }
         }
+        __s_pos++;
+    }
+    if ( n )
+    {
+        ssd1306_intf.send_buffer( chunk, n );
     }
-    __s_pos++;
 }
 
-static void ssd1325_sendPixelsBuffer(const uint8_t *buffer, uint16_t len)
+static void ssd1325_sendPixels(uint8_t data)
 {
-    while (len--)
-    {
-        ssd1325_sendPixels(*buffer);
-        buffer++;
-    }
+    ssd1325_sendPixelsBuffer( &data, 1 );
 }
 
 //////////////////////// SSD1331 NATIVE MODE ///////////////////////////////////
@@ -163,6 +170,7 @@ void    ssd1325_128x64_init()
     ssd1306_lcd.send_pixels_buffer1 = ssd1325_sendPixelsBuffer;
     // Set function for 8-bit mode
     ssd1306_lcd.send_pixels8 = ssd1306_intf.send;
+    ssd1306_lcd.send_pixels_buffer8 = ssd1306_intf.send_buffer;
     ssd1306_lcd.set_mode = ssd1325_setMode;
     // Use one of 2 functions for initialization below
     // Please, read help on this functions and read datasheet before you decide, which
@@ -91,8 +91,6 @@ static void set_block_compat(lcduint_t x, lcduint_t y, lcduint_t w)
     ssd1306_spiDataMode(1);
 }
 
-static void ssd1327_sendPixels(uint8_t data);
-
 static void next_page_compat(void)
 {
     ssd1306_intf.stop();
@@ -101,26 +99,6 @@ static void next_page_compat(void)
 
 //SSD1306_COMPAT_SPI_BLOCK_8BIT_CMDS( 0x15, 0x75 );
 
-static void ssd1327_sendPixels(uint8_t data)
-{
-    if (!(__s_pos & 0x01))
-    {
-        __s_leftPixel = data;
-        data = 0x00;
-    }
-    if ((__s_pos & 0x01) || (__s_pos == __s_column + __s_w2 - 1))
-    {
-        for (uint8_t i=8; i>0; i--)
-        {
-            uint8_t color = (__s_leftPixel & 0x01) ? (ssd1306_color & 0x0F) : 0;
-            color |= (((data & 0x01) ? (ssd1306_color & 0x0F): 0) << 4);
-            ssd1306_intf.send(color);
-            data >>= 1;
-            __s_leftPixel >>= 1;
-        }
-    }
-    __s_pos++;
-}
 
 static void ssd1327_sendPixels8(uint8_t data)
 {
@@ -129,13 +107,40 @@ static void ssd1327_sendPixels8(uint8_t data)
 
 static void ssd1327_sendPixelsBuffer(const uint8_t *buffer, uint16_t len)
 {
+    uint8_t chunk[32];
+    uint8_t n = 0;
     while (len--)
     {
-        ssd1327_sendPixels(*buffer);
-        buffer++;
+        uint8_t data = *buffer++;
+        if (!(__s_pos & 0x01))
+        {
+            __s_leftPixel = data;
+            data = 0x00;
+        }
+        if ((__s_pos & 0x01) || (__s_pos == __s_column + __s_w2 - 1))
+        {
+            // Each 2 columns are packed to 8 bytes: 2 pixels per byte
+            ssd1306_expandMonoPixels4( __s_leftPixel, data, ssd1306_color, &chunk[n] );
+            n += 8;
+            if ( n == sizeof(chunk) )
+            {
+                ssd1306_intf.send_buffer( chunk, n );
+                n = 0;
+            }
+        }
+        __s_pos++;
+    }
+    if ( n )
+    {
+        ssd1306_intf.send_buffer( chunk, n );
     }
 }
 
+static void ssd1327_sendPixels(uint8_t data)
+{
+    ssd1327_sendPixelsBuffer( &data, 1 );
+}
+
 //////////////////////// SSD1331 NATIVE MODE ///////////////////////////////////
 
 CONTROLLER_NATIVE_SPI_BLOCK_8BIT_CMDS( 0x15, 0x75 );
@@ -175,6 +180,7 @@ void    ssd1327_128x128_init()
     ssd1306_lcd.send_pixels_buffer1 = ssd1327_sendPixelsBuffer;
     // Set function for 8-bit mode
     ssd1306_lcd.send_pixels8 = ssd1327_sendPixels8;
+    ssd1306_lcd.send_pixels_buffer8 = ssd1306_intf.send_buffer;
     ssd1306_lcd.set_mode = ssd1327_setMode;
     // Use one of 2 functions for initialization below
     // Please, read help on this functions and read datasheet before you decide, which
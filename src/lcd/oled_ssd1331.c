@@ -90,6 +90,12 @@ static const PROGMEM uint8_t s_oled96x64_initData16[] =
 };
 
 static uint8_t s_rotation = 0x04;
+static uint8_t s_pixelBytes = 1;
+
+/* SSD1331 needs some time to complete graphic acceleration command */
+#define SSD1331_ACCEL_DELAY_US   250
+/* Each pixel of a line, drawn without acceleration, is preceded by set_block() command */
+#define SSD1331_BLOCK_CMD_BYTES  6
 
 //////////////////////// SSD1306 COMPATIBLE MODE ///////////////////////////////
 
@@ -198,6 +204,97 @@ static void    ssd1331_sendPixel16(uint16_t color)
     ssd1306_intf.send( color & 0xFF );
 }
 
+// Sends color as 6-bit C, B, A (blue, green, red) components of graphic acceleration commands
+static void    ssd1331_sendColor(uint16_t color)
+{
+    ssd1306_intf.send( (color & 0x001F) << 1 );
+    ssd1306_intf.send( (color & 0x07E0) >> 5 );
+    ssd1306_intf.send( (color & 0xF800) >> 10 );
+}
+
+static uint8_t ssd1331_canAccelerate(lcdint_t x1, lcdint_t y1, lcdint_t x2, lcdint_t y2)
+{
+    // Callbacks can be left from ssd1331 after switching to other display (some RGB drivers
+    // also report LCD_TYPE_SSD1331), so check that ssd1331 driver is still active.
+    // Acceleration commands use GDRAM coordinates, so only unrotated normal mode is supported.
+    return (ssd1306_lcd.set_mode == ssd1331_setMode) && (s_rotation == 0) &&
+           (x1 >= 0) && (y1 >= 0) &&
+           (x2 < (lcdint_t)ssd1306_lcd.width) && (y2 < (lcdint_t)ssd1306_lcd.height);
+}
+
+// Returns number of bytes, spi bus transfers during acceleration delay. If pixels take
+// less bytes, it is faster to send them, than to wait for the controller.
+static uint16_t ssd1331_accelMinBytes(void)
+{
+    return (uint32_t)SSD1331_ACCEL_DELAY_US * (s_ssd1306_spi_clock / 100000) / 80;
+}
+
+static void ssd1331_endAccelCommand(void)
+{
+    ssd1306_intf.stop();
+#if defined(__linux__) && !defined(ARDUINO)
+    // Linux spidev interface only queues the data on stop(), so wait until command
+    // really reaches the controller before counting its execution time.
+    ssd1306_platform_spiFlush();
+#endif
+    delayMicroseconds(SSD1331_ACCEL_DELAY_US);
+}
+
+static uint8_t ssd1331_fillRectAccel(lcdint_t x1, lcdint_t y1, lcdint_t x2, lcdint_t y2, uint16_t color)
+{
+    if ( !ssd1331_canAccelerate(x1, y1, x2, y2) ||
+         (uint32_t)(x2 - x1 + 1) * (y2 - y1 + 1) * s_pixelBytes < ssd1331_accelMinBytes() )
+    {
+        return 0;
+    }
+    ssd1306_intf.start();
+    ssd1306_spiDataMode(0);
+    if ( color == 0 )
+    {
+        ssd1306_intf.send(SSD1331_CLEARWINDOW);
+        ssd1306_intf.send(x1);
+        ssd1306_intf.send(y1);
+        ssd1306_intf.send(x2);
+        ssd1306_intf.send(y2);
+    }
+    else
+    {
+        ssd1306_intf.send(SSD1331_FILL);
+        ssd1306_intf.send(0x01);
+        ssd1306_intf.send(SSD1331_DRAWRECT);
+        ssd1306_intf.send(x1);
+        ssd1306_intf.send(y1);
+        ssd1306_intf.send(x2);
+        ssd1306_intf.send(y2);
+        ssd1331_sendColor(color); // outline
+        ssd1331_sendColor(color); // fill
+    }
+    ssd1331_endAccelCommand();
+    return 1;
+}
+
+static uint8_t ssd1331_drawLineAccel(lcdint_t x1, lcdint_t y1, lcdint_t x2, lcdint_t y2, uint16_t color)
+{
+    lcdint_t dx = x1 < x2 ? x2 - x1: x1 - x2;
+    lcdint_t dy = y1 < y2 ? y2 - y1: y1 - y2;
+    if ( !ssd1331_canAccelerate(x1 < x2 ? x1: x2, y1 < y2 ? y1: y2,
+                                x1 < x2 ? x2: x1, y1 < y2 ? y2: y1) ||
+         (uint32_t)((dx > dy ? dx: dy) + 1) * (SSD1331_BLOCK_CMD_BYTES + s_pixelBytes) < ssd1331_accelMinBytes() )
+    {
+        return 0;
+    }
+    ssd1306_intf.start();
+    ssd1306_spiDataMode(0);
+    ssd1306_intf.send(SSD1331_DRAWLINE);
+    ssd1306_intf.send(x1);
+    ssd1306_intf.send(y1);
+    ssd1306_intf.send(x2);
+    ssd1306_intf.send(y2);
+    ssd1331_sendColor(color);
+    ssd1331_endAccelCommand();
+    return 1;
+}
+
 void    ssd1331_96x64_init()
 {
     ssd1306_lcd.type = LCD_TYPE_SSD1331;
@@ -208,9 +305,14 @@ void    ssd1331_96x64_init()
     ssd1306_lcd.send_pixels1  = send_pixels_compat;
     ssd1306_lcd.send_pixels_buffer1 = send_pixels_buffer_compat;
 
+    s_pixelBytes = 1;
     ssd1306_lcd.send_pixels8 = ssd1306_intf.send;
     ssd1306_lcd.send_pixels16 = ssd1331_sendPixel16_8;
+    ssd1306_lcd.send_pixels_buffer8 = ssd1306_intf.send_buffer;
+    ssd1306_lcd.send_pixels_buffer16 = ssd1306_sendPixelsBuffer16To8;
     ssd1306_lcd.set_mode = ssd1331_setMode;
+    ssd1306_lcd.fill_rect = ssd1331_fillRectAccel;
+    ssd1306_lcd.draw_line = ssd1331_drawLineAccel;
     for( uint8_t i=0; i<sizeof(s_oled96x64_initData); i++)
     {
         ssd1306_sendCommand(pgm_read_byte(&s_oled96x64_initData[i]));
@@ -227,9 +329,14 @@ void    ssd1331_96x64_init16()
     ssd1306_lcd.send_pixels1  = send_pixels_compat16;
     ssd1306_lcd.send_pixels_buffer1 = send_pixels_buffer_compat16;
 
+    s_pixelBytes = 2;
     ssd1306_lcd.send_pixels8 = ssd1331_sendPixel8_16;
     ssd1306_lcd.send_pixels16 = ssd1331_sendPixel16;
+    ssd1306_lcd.send_pixels_buffer8 = ssd1306_sendPixelsBuffer8To16;
+    ssd1306_lcd.send_pixels_buffer16 = ssd1306_intf.send_buffer;
     ssd1306_lcd.set_mode = ssd1331_setMode;
+    ssd1306_lcd.fill_rect = ssd1331_fillRectAccel;
+    ssd1306_lcd.draw_line = ssd1331_drawLineAccel;
     for( uint8_t i=0; i<sizeof(s_oled96x64_initData16); i++)
     {
         ssd1306_sendCommand(pgm_read_byte(&s_oled96x64_initData16[i]));
@@ -265,9 +372,16 @@ void ssd1331_drawLine(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, uint16_t c
     ssd1306_intf.send(y1);
     ssd1306_intf.send(x2);
     ssd1306_intf.send(y2);
-    ssd1306_intf.send( (color & 0x03) << 4 );
-    ssd1306_intf.send( (color & 0x1C) << 2 );
-    ssd1306_intf.send( (color & 0xE0) >> 2 );
+    ssd1331_sendColor( RGB8_TO_RGB16(color) );
+    ssd1306_intf.stop();
+}
+
+void ssd1331_setStartLine(uint8_t line)
+{
+    ssd1306_intf.start();
+    ssd1306_spiDataMode(0);
+    ssd1306_intf.send(SSD1331_SETSTARTLINE);
+    ssd1306_intf.send(line & 0x3F);
     ssd1306_intf.stop();
 }
 
@@ -275,7 +389,7 @@ void ssd1331_copyBlock(uint8_t left, uint8_t top, uint8_t right, uint8_t bottom,
 {
     ssd1306_intf.start();
     ssd1306_spiDataMode(0);
-    ssd1306_intf.send(0x23);
+    ssd1306_intf.send(SSD1331_COPY);
     ssd1306_intf.send(left);
     ssd1306_intf.send(top);
     ssd1306_intf.send(right);
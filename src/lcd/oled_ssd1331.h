@@ -116,6 +116,15 @@ void         ssd1331_96x64_spi_init16(int8_t rstPin, int8_t cesPin, int8_t dcPin
  */
 void         ssd1331_drawLine(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, uint16_t color);
 
+/**
+ * Sets start line in GDRAM to start display content with.
+ * Can be used with NanoEngine hardware scroll, see NanoEngineTiler::enableHardwareScroll().
+ *
+ * @param line start line in range 0 - 63
+ * @note This API can be used only with ssd1331 RGB oled displays
+ */
+void ssd1331_setStartLine(uint8_t line);
+
 /**
  * Copies block in GDRAM to new position
  * @param left column start of block to copy
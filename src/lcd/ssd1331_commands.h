@@ -38,6 +38,11 @@ enum ESsd1331Commands
 {
     SSD1331_COLUMNADDR       = 0x15,
     SSD1331_DRAWLINE         = 0x21,
+    SSD1331_DRAWRECT         = 0x22,
+    SSD1331_COPY             = 0x23,
+    SSD1331_DIMWINDOW        = 0x24,
+    SSD1331_CLEARWINDOW      = 0x25,
+    SSD1331_FILL             = 0x26,
     SSD1331_ROWADDR          = 0x75,
     SSD1331_CONTRASTA        = 0x81,
     SSD1331_CONTRASTB        = 0x82,
@@ -31,6 +31,7 @@
 
 #include "nano_engine/sprite.h"
 #include "nano_engine/canvas.h"
+#include "nano_engine/text_layout.h"
 #include "nano_engine/adafruit.h"
 #include "nano_engine/tiler.h"
 #include "nano_engine/core.h"
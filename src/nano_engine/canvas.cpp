@@ -23,6 +23,8 @@
 */
 
 #include "canvas.h"
+#include "canvas_kernels.h"
+#include "ssd1306_rle.h"
 #include "lcd/lcd_common.h"
 #include "ssd1306.h"
 
@@ -115,6 +117,74 @@ void NanoCanvasOps<BPP>::fillRect(const NanoRect &rect)
     fillRect(rect.p1.x, rect.p1.y, rect.p2.x, rect.p2.y);
 }
 
+template <uint8_t BPP>
+void NanoCanvasOps<BPP>::drawRleBitmap1(lcdint_t xpos, lcdint_t ypos, lcduint_t w, lcduint_t h, const uint8_t *bitmap)
+{
+    uint8_t chunk[16];
+    SRleDecoder rle;
+    lcdint_t x1 = xpos - offset.x;
+    lcdint_t y1 = ypos - offset.y;
+    if ((x1 + (lcdint_t)w <= 0) || (x1 >= (lcdint_t)m_w)) return;
+    if ((y1 + (lcdint_t)h <= 0) || (y1 >= (lcdint_t)m_h)) return;
+    /* columns of the bitmap, which are out of canvas, are skipped in compressed stream */
+    lcduint_t left = x1 < 0 ? -x1 : 0;
+    lcduint_t right = (x1 + (lcdint_t)w > (lcdint_t)m_w) ? (x1 + w - m_w) : 0;
+    bool transparent = m_textMode & CANVAS_MODE_TRANSPARENT;
+    uint16_t color = m_color;
+    ssd1306_rleInit(&rle, bitmap);
+    for (lcduint_t j = 0; j < h; j += 8)
+    {
+        lcdint_t y = ypos + (lcdint_t)j;
+        if (y1 + (lcdint_t)j >= (lcdint_t)m_h) break;
+        if (y1 + (lcdint_t)j + 8 <= 0)
+        {
+            ssd1306_rleSkip(&rle, w);
+            continue;
+        }
+        uint8_t rows = (h - j) < 8 ? (h - j) : 8;
+        ssd1306_rleSkip(&rle, left);
+        for (lcduint_t i = left; i < w - right; )
+        {
+            uint8_t n = (w - right - i) < sizeof(chunk) ? (w - right - i) : sizeof(chunk);
+            ssd1306_rleRead(&rle, chunk, n);
+            for (uint8_t k = 0; k < n; k++, i++)
+            {
+                for (uint8_t row = 0; row < rows; row++)
+                {
+                    if ( chunk[k] & (1 << row) )
+                    {
+                        m_color = color;
+                    }
+                    else if ( !transparent )
+                    {
+                        m_color = 0;
+                    }
+                    else
+                    {
+                        continue;
+                    }
+                    putPixel(xpos + (lcdint_t)i, y + row);
+                }
+            }
+        }
+        ssd1306_rleSkip(&rle, right);
+    }
+    m_color = color;
+}
+
+template <uint8_t BPP>
+void NanoCanvasOps<BPP>::drawGlyph(lcdint_t x, lcdint_t y, const SCharInfo &char_info)
+{
+    if ( s_fixedFont.h.type == SSD1306_RLE_FONT_TYPE )
+    {
+        drawRleBitmap1(x, y, char_info.width, char_info.height, char_info.glyph);
+    }
+    else
+    {
+        drawBitmap1(x, y, char_info.width, char_info.height, char_info.glyph);
+    }
+}
+
 template <uint8_t BPP>
 uint8_t NanoCanvasOps<BPP>::printChar(uint8_t c)
 {
@@ -125,11 +195,7 @@ uint8_t NanoCanvasOps<BPP>::printChar(uint8_t c)
     uint8_t mode = m_textMode;
     for (uint8_t i = 0; i<(m_fontStyle == STYLE_BOLD ? 2: 1); i++)
     {
-        drawBitmap1(m_cursorX + i,
-                    m_cursorY,
-                    char_info.width,
-                    char_info.height,
-                    char_info.glyph );
+        drawGlyph(m_cursorX + i, m_cursorY, char_info);
         m_textMode |= CANVAS_MODE_TRANSPARENT;
     }
     m_textMode = mode;
@@ -399,7 +465,7 @@ void NanoCanvasOps<1>::drawBitmap1(lcdint_t x, lcdint_t y, lcduint_t w, lcduint_
             if (CANVAS_MODE_TRANSPARENT != (m_textMode & CANVAS_MODE_TRANSPARENT))
             {
                 m_buf[addr] &= ~mask;
-                m_buf[addr] |= m_color == BLACK ? ~data: data;
+                m_buf[addr] |= (m_color == BLACK ? ~data: data) & mask;
             }
             else
             {
@@ -416,6 +482,66 @@ void NanoCanvasOps<1>::drawBitmap1(lcdint_t x, lcdint_t y, lcduint_t w, lcduint_
     }
 }
 
+template <>
+void NanoCanvasOps<1>::drawRleBitmap1(lcdint_t x, lcdint_t y, lcduint_t w, lcduint_t h, const uint8_t *bitmap)
+{
+    uint8_t chunk[16];
+    SRleDecoder rle;
+    x -= offset.x;
+    y -= offset.y;
+    if ((x + (lcdint_t)w <= 0) || (x >= (lcdint_t)m_w)) return;
+    if ((y + (lcdint_t)h <= 0) || (y >= (lcdint_t)m_h)) return;
+    lcduint_t left = x < 0 ? -x : 0;
+    lcduint_t right = (x + (lcdint_t)w > (lcdint_t)m_w) ? (x + w - m_w) : 0;
+    /* Each bitmap page row covers 2 canvas pages, if y is not aligned to 8 pixels */
+    uint8_t offs = y & 0x07;
+    lcdint_t page = y >> 3;
+    lcdint_t pages = (lcdint_t)((m_h + 7) >> 3);
+    bool transparent = m_textMode & CANVAS_MODE_TRANSPARENT;
+    ssd1306_rleInit(&rle, bitmap);
+    for (lcduint_t j = 0; j < h; j += 8, page++)
+    {
+        if (page >= pages) break;
+        if (page < -1)
+        {
+            ssd1306_rleSkip(&rle, w);
+            continue;
+        }
+        uint8_t rowMask = (h - j) < 8 ? (0xFF >> (8 - (h - j))) : 0xFF;
+        ssd1306_rleSkip(&rle, left);
+        for (lcduint_t i = left; i < w - right; )
+        {
+            uint8_t n = (w - right - i) < sizeof(chunk) ? (w - right - i) : sizeof(chunk);
+            ssd1306_rleRead(&rle, chunk, n);
+            for (uint8_t k = 0; k < n; k++, i++)
+            {
+                uint8_t data = chunk[k] & rowMask;
+                for (uint8_t part = 0; part < (offs ? 2 : 1); part++)
+                {
+                    lcdint_t p = page + part;
+                    if ((p < 0) || (p >= pages)) continue;
+                    uint8_t d = part ? (data >> (8 - offs)) : (data << offs);
+                    uint8_t mask = part ? (rowMask >> (8 - offs)) : (rowMask << offs);
+                    uint8_t *buf = &m_buf[BANK_ADDR1(p) + x + i];
+                    if ( !transparent )
+                    {
+                        *buf = (*buf & ~mask) | ((m_color == BLACK ? ~d : d) & mask);
+                    }
+                    else if (m_color == BLACK)
+                    {
+                        *buf &= ~d;
+                    }
+                    else
+                    {
+                        *buf |= d;
+                    }
+                }
+            }
+        }
+        ssd1306_rleSkip(&rle, right);
+    }
+}
+
 template <>
 void NanoCanvasOps<1>::drawXBitmap1(lcdint_t x, lcdint_t y, lcduint_t w, lcduint_t h, const uint8_t *bitmap)
 {
@@ -427,8 +553,6 @@ void NanoCanvasOps<1>::drawXBitmap1(lcdint_t x, lcdint_t y, lcduint_t w, lcduint
     if (x + (lcdint_t)w <= 0) return;
     if (x >= (lcdint_t)m_w)  return;
 
-    delay(100);
-
     uint8_t start_bit = 0;
     lcduint_t pitch_delta = 0;
     if (y < 0)
@@ -521,7 +645,12 @@ void NanoCanvas1::blt()
 
 void NanoCanvas1::blt(const NanoRect &rect)
 {
-    // TODO: NOT IMPLEMENTED
+    /* Buffer lines are pages of 8 pixels, so send the rectangle page by page */
+    for (lcdint_t y = rect.p1.y & ~7; y <= rect.p2.y; y += 8)
+    {
+        ssd1306_drawBufferFast(offset.x + rect.p1.x, offset.y + y, rect.width(), 8,
+                               m_buf + (y >> 3) * m_w + rect.p1.x);
+    }
 }
 
 //                 NANO CANVAS 1_8
@@ -538,7 +667,11 @@ void NanoCanvas1_8::blt()
 
 void NanoCanvas1_8::blt(const NanoRect &rect)
 {
-    // TODO: NOT IMPLEMENTED
+    for (lcdint_t y = rect.p1.y & ~7; y <= rect.p2.y; y += 8)
+    {
+        ssd1306_drawMonoBuffer8(offset.x + rect.p1.x, offset.y + y, rect.width(), 8,
+                                m_buf + (y >> 3) * m_w + rect.p1.x);
+    }
 }
 
 //                 NANO CANVAS 1_16
@@ -555,7 +688,11 @@ void NanoCanvas1_16::blt()
 
 void NanoCanvas1_16::blt(const NanoRect &rect)
 {
-    // TODO: NOT IMPLEMENTED
+    for (lcdint_t y = rect.p1.y & ~7; y <= rect.p2.y; y += 8)
+    {
+        ssd1306_drawMonoBuffer16(offset.x + rect.p1.x, offset.y + y, rect.width(), 8,
+                                 m_buf + (y >> 3) * m_w + rect.p1.x);
+    }
 }
 
 /////////////////////////////////////////////////////////////////////////////////
@@ -763,14 +900,28 @@ void NanoCanvasOps<4>::drawBitmap8(lcdint_t xpos, lcdint_t ypos, lcduint_t w, lc
          //xb2 -= (x2 - (lcdint_t)m_w + 1);
          x2 = (lcdint_t)m_w - 1;
     }
+    bool transparent = m_textMode & CANVAS_MODE_TRANSPARENT;
     for ( lcdint_t y = y1; y <= y2; y++ )
     {
         for ( lcdint_t x = x1; x <= x2; x++ )
         {
             uint16_t src_addr8 = xb1 + x - x1 + ((yb1 + y - y1)) * w;
-            uint8_t data = pgm_read_byte( &bitmap[ src_addr8 ] );
             uint16_t addr = YADDR4(y) + x / 2;
-            if ( (data) || (!(m_textMode & CANVAS_MODE_TRANSPARENT)) )
+            if ( !transparent && !(x & 1) && (x < x2) )
+            {
+                /* Convert pixels, filling whole bytes of canvas, at once */
+                uint8_t chunk[32];
+                uint8_t n = min(x2 - x + 1, (lcdint_t)sizeof(chunk)) & ~1;
+                for (uint8_t i = 0; i < n; i++)
+                {
+                    chunk[i] = pgm_read_byte( &bitmap[ src_addr8 + i ] );
+                }
+                ssd1306_convertRgb8ToGray4( &m_buf[ addr ], chunk, n );
+                x += n - 1;
+                continue;
+            }
+            uint8_t data = pgm_read_byte( &bitmap[ src_addr8 ] );
+            if ( (data) || (!transparent) )
             {
                 data = RGB8_TO_GRAY4(data);
                 m_buf[ addr ] &= ~(0x0F << BITS_SHIFT4(x));
@@ -816,7 +967,37 @@ void NanoCanvas1_4::blt()
 
 void NanoCanvas1_4::blt(const NanoRect &rect)
 {
-    // TODO: NOT IMPLEMENTED
+    /* Draw whole canvas lines, covering the rectangle, since the function has no pitch */
+    ssd1306_drawBuffer1_4(offset.x,
+                          offset.y + rect.p1.y,
+                          m_w,
+                          rect.height(),
+                          m_buf + rect.p1.y * (m_w >> 1) );
+}
+
+//                 NANO CANVAS 4
+
+void NanoCanvas4::blt(lcdint_t x, lcdint_t y)
+{
+    ssd1306_drawBufferFast4(x, y, m_w, m_h, m_buf);
+}
+
+void NanoCanvas4::blt()
+{
+    ssd1306_drawBufferFast4(offset.x, offset.y, m_w, m_h, m_buf);
+}
+
+void NanoCanvas4::blt(const NanoRect &rect)
+{
+    /* Controller columns hold 2 pixels, so rectangle is aligned to even pixels */
+    lcdint_t x1 = rect.p1.x & ~1;
+    lcdint_t x2 = rect.p2.x | 1;
+    ssd1306_drawBufferEx8((offset.x + x1) >> 1,
+                          offset.y + rect.p1.y,
+                          (x2 - x1 + 1) >> 1,
+                          rect.height(),
+                          m_w >> 1,
+                          m_buf + (x1 >> 1) + YADDR4(rect.p1.y) );
 }
 
 /////////////////////////////////////////////////////////////////////////////////
@@ -877,12 +1058,7 @@ void NanoCanvasOps<8>::drawHLine(lcdint_t x1, lcdint_t y1, lcdint_t x2)
     if ((y1 < 0) || (y1 >= (lcdint_t)m_h)) return;
     x1 = max(x1,0);
     x2 = min(x2,(lcdint_t)m_w-1);
-    uint8_t *buf = m_buf + YADDR8(y1) + x1;
-    for (lcdint_t x = 0; x <= x2 - x1; x++)
-    {
-        *buf = m_color;
-        buf++;
-    }
+    memset(m_buf + YADDR8(y1) + x1, m_color, x2 - x1 + 1);
 }
 
 template <>
@@ -909,12 +1085,8 @@ void NanoCanvasOps<8>::fillRect(lcdint_t x1, lcdint_t y1, lcdint_t x2, lcdint_t
     uint8_t *buf = m_buf + YADDR8(y1) + x1;
     for (lcdint_t y = y1; y <= y2; y++)
     {
-        for (lcdint_t x = x1; x <= x2; x++)
-        {
-            *buf = m_color;
-            buf++;
-        }
-        buf += ((lcdint_t)(m_w) - (x2 - x1 + 1));
+        memset(buf, m_color, x2 - x1 + 1);
+        buf += m_w;
     }
 }
 
@@ -951,24 +1123,18 @@ void NanoCanvasOps<8>::drawBitmap1(lcdint_t xpos, lcdint_t ypos, lcduint_t w, lc
          x2 = (lcdint_t)m_w - 1;
     }
     uint8_t offs2 = 8 - offs;
+    bool transparent = m_textMode & CANVAS_MODE_TRANSPARENT;
     lcdint_t y = y1;
     while ( y <= y2)
     {
-        for ( lcdint_t x = x1; x <= x2; x++ )
+        /* Process bitmap page row by row */
+        uint8_t *buf = m_buf + YADDR8(y) + x1;
+        for (uint8_t n = offs; n < min(y2 - y + 1, (lcdint_t)offs2) + offs; n++)
         {
-            uint8_t data = pgm_read_byte( bitmap );
-            uint16_t addr = YADDR8(y) + x;
-            for (uint8_t n = 0; n < min(y2 - y + 1, 8); n++)
-            {
-                if ( data & (1<<(n + offs)) )
-                    m_buf[addr] = m_color;
-                else if (!(m_textMode & CANVAS_MODE_TRANSPARENT))
-                    m_buf[addr] = 0x00;
-                addr += (lcduint_t)m_w;
-            }
-            bitmap++;
+            canvas_expand1_8(buf, bitmap, x2 - x1 + 1, 1<<n, m_color, transparent);
+            buf += m_w;
         }
-        bitmap += (w - (x2 - x1 + 1));
+        bitmap += w;
         y = y + offs2;
         offs = 0;
         offs2 = 8;
@@ -1071,20 +1237,11 @@ void NanoCanvasOps<8>::drawBitmap8(lcdint_t xpos, lcdint_t ypos, lcduint_t w, lc
     {
          x2 = (lcdint_t)m_w - 1;
     }
-    lcdint_t y = y1;
-    while ( y <= y2 )
+    bool transparent = m_textMode & CANVAS_MODE_TRANSPARENT;
+    for (lcdint_t y = y1; y <= y2; y++)
     {
-        for ( lcdint_t x = x1; x <= x2; x++ )
-        {
-            uint8_t data = pgm_read_byte( bitmap );
-            if ( (data) || (!(m_textMode & CANVAS_MODE_TRANSPARENT)) )
-            {
-                m_buf[YADDR8(y) + x] = data;
-            }
-            bitmap++;
-        }
-        bitmap += (w - (x2 - x1 + 1));
-        y++;
+        canvas_blit8(m_buf + YADDR8(y) + x1, bitmap, x2 - x1 + 1, transparent);
+        bitmap += w;
     }
 }
 
@@ -1194,13 +1351,7 @@ void NanoCanvasOps<16>::drawHLine(lcdint_t x1, lcdint_t y1, lcdint_t x2)
     if ((y1 < 0) || (y1 >= (lcdint_t)m_h)) return;
     x1 = max(x1,0);
     x2 = min(x2,(lcdint_t)m_w-1);
-    uint8_t *buf = m_buf + YADDR16(y1) + (x1<<1);
-    for (lcdint_t x = 0; x <= x2 - x1; x++)
-    {
-        buf[0] = m_color >> 8;
-        buf[1] = m_color & 0xFF;
-        buf+=2;
-    }
+    canvas_fill16(m_buf + YADDR16(y1) + (x1<<1), m_color, x2 - x1 + 1);
 }
 
 template <>
@@ -1227,13 +1378,8 @@ void NanoCanvasOps<16>::fillRect(lcdint_t x1, lcdint_t y1, lcdint_t x2, lcdint_t
     uint8_t *buf = m_buf + YADDR16(y1) + (x1<<1);
     for (lcdint_t y = y1; y <= y2; y++)
     {
-        for (lcdint_t x = x1; x <= x2; x++)
-        {
-            buf[0] = m_color >> 8;
-            buf[1] = m_color & 0xFF;
-            buf+=2;
-        }
-        buf += ( ((lcdint_t)(m_w) - (x2 - x1 + 1)) <<1 );
+        canvas_fill16(buf, m_color, x2 - x1 + 1);
+        buf += (m_w<<1);
     }
 }
 
@@ -1270,30 +1416,18 @@ void NanoCanvasOps<16>::drawBitmap1(lcdint_t xpos, lcdint_t ypos, lcduint_t w, l
          x2 = (lcdint_t)m_w - 1;
     }
     uint8_t offs2 = 8 - offs;
+    bool transparent = m_textMode & CANVAS_MODE_TRANSPARENT;
     lcdint_t y = y1;
     while ( y <= y2)
     {
-        for ( lcdint_t x = x1; x <= x2; x++ )
+        /* Process bitmap page row by row */
+        uint8_t *buf = m_buf + YADDR16(y) + (x1<<1);
+        for (uint8_t n = offs; n < min(y2 - y + 1, (lcdint_t)offs2) + offs; n++)
         {
-            uint8_t data = pgm_read_byte( bitmap );
-            uint16_t addr = YADDR16(y) + (x<<1);
-            for (uint8_t n = 0; n < min(y2 - y + 1, 8); n++)
-            {
-                if ( data & (1<<(n + offs)) )
-                {
-                    m_buf[addr] = m_color >> 8;
-                    m_buf[addr+1] = m_color & 0xFF;
-                }
-                else if (!(m_textMode & CANVAS_MODE_TRANSPARENT))
-                {
-                    m_buf[addr] = 0x00;
-                    m_buf[addr+1] = 0x00;
-                }
-                addr += ((lcduint_t)m_w << 1);
-            }
-            bitmap++;
+            canvas_expand1_16(buf, bitmap, x2 - x1 + 1, 1<<n, m_color, transparent);
+            buf += (m_w<<1);
         }
-        bitmap += (w - (x2 - x1 + 1));
+        bitmap += w;
         y = y + offs2;
         offs = 0;
         offs2 = 8;
@@ -1398,23 +1532,11 @@ void NanoCanvasOps<16>::drawBitmap8(lcdint_t xpos, lcdint_t ypos, lcduint_t w, l
     {
          x2 = (lcdint_t)m_w - 1;
     }
-    lcdint_t y = y1;
-    while ( y <= y2 )
+    bool transparent = m_textMode & CANVAS_MODE_TRANSPARENT;
+    for (lcdint_t y = y1; y <= y2; y++)
     {
-        for ( lcdint_t x = x1; x <= x2; x++ )
-        {
-            uint8_t data = pgm_read_byte( bitmap );
-            if ( (data) || (!(m_textMode & CANVAS_MODE_TRANSPARENT)) )
-            {
-                uint16_t color = (((uint16_t)data & 0b11100000) << 8) |
-                                 (((uint16_t)data & 0b00011100) << 6) |
-                                 (((uint16_t)data & 0b00000011) << 3);
-                m_buf[YADDR16(y) + (x<<1)] = color;
-            }
-            bitmap++;
-        }
-        bitmap += (w - (x2 - x1 + 1));
-        y++;
+        canvas_blit8to16(m_buf + YADDR16(y) + (x1<<1), bitmap, x2 - x1 + 1, transparent);
+        bitmap += w;
     }
 }
 
@@ -1475,3 +1597,25 @@ void NanoCanvas16::blt(const NanoRect &rect)
                            m_w<<1,
                            m_buf + (rect.p1.x<<1) + rect.p1.y * (m_w<<1) );
 }
+
+//                 NANO CANVAS 16_1
+
+void NanoCanvas16_1::blt(lcdint_t x, lcdint_t y)
+{
+    ssd1306_drawBuffer16ToMono(x, y, m_w, m_h, m_buf);
+}
+
+void NanoCanvas16_1::blt()
+{
+    ssd1306_drawBuffer16ToMono(offset.x, offset.y, m_w, m_h, m_buf);
+}
+
+void NanoCanvas16_1::blt(const NanoRect &rect)
+{
+    ssd1306_drawBufferEx16ToMono(offset.x + rect.p1.x,
+                                 offset.y + rect.p1.y,
+                                 rect.width(),
+                                 rect.height(),
+                                 m_w<<1,
+                                 m_buf + (rect.p1.x<<1) + rect.p1.y * (m_w<<1) );
+}
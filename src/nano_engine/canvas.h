@@ -246,6 +246,31 @@ public:
      */
     void drawXBitmap1(lcdint_t x, lcdint_t y, lcduint_t w, lcduint_t h, const uint8_t *bitmap);
 
+    /**
+     * @brief Draws RLE compressed monochrome bitmap in color buffer using color, specified via setColor() method
+     * Draws RLE compressed monochrome bitmap in color buffer using color, specified via setColor() method.
+     * The bitmap is expected in Native ssd1306 controller format, compressed as described in ssd1306_rle.h.
+     * The bitmap is decoded on the fly, columns and pages out of canvas are skipped without decoding.
+     *
+     * @param x - position X in pixels
+     * @param y - position Y in pixels
+     * @param w - width in pixels
+     * @param h - height in pixels
+     * @param bitmap - compressed monochrome bitmap data, located in flash
+     *
+     * @note Transparent and non-transparent modes are supported the same way as for drawBitmap1().
+     */
+    void drawRleBitmap1(lcdint_t x, lcdint_t y, lcduint_t w, lcduint_t h, const uint8_t *bitmap);
+
+    /**
+     * Draws char glyph, found by ssd1306_getCharBitmap(), in canvas buffer.
+     * Plain and RLE compressed fonts are supported.
+     * @param x - position X in pixels
+     * @param y - position Y in pixels
+     * @param char_info - glyph information
+     */
+    void drawGlyph(lcdint_t x, lcdint_t y, const SCharInfo &char_info);
+
     /**
      * @brief Draws 8-bit color bitmap in color buffer.
      * Draws 8-bit color bitmap in color buffer.
@@ -517,6 +542,46 @@ public:
      * If canvas offset is {12,3}, then canvas area {8,0}-{15,7} will be copied
      * to screen at position {20,3}.
      * @param rect rectagle describing part of canvas to move to display.
+     * @note whole canvas lines, covering the rectangle, are sent to the display.
+     */
+    void blt(const NanoRect &rect) override;
+};
+
+/**
+ * NanoCanvas4 represents objects for drawing in memory buffer
+ * NanoCanvas4 represents each pixel as 4-bits in GRAYscale: 11112222
+ * Unlike NanoCanvas1_4, NanoCanvas4 outputs canvas to ssd1325/ssd1327 display in normal mode
+ * row by row, so buffer is sent without conversion. Use ssd1306_setMode(LCD_MODE_NORMAL)
+ * before drawing.
+ */
+class NanoCanvas4: public NanoCanvasBase<4>
+{
+public:
+    using NanoCanvasBase::NanoCanvasBase;
+
+    /**
+     * Draws canvas on the LCD display
+     * @param x - horizontal position in pixels (must be even)
+     * @param y - vertical position in pixels
+     */
+    void blt(lcdint_t x, lcdint_t y) override;
+
+    /**
+     * Draws canvas on the LCD display using offset values.
+     */
+    void blt() override;
+
+    /**
+     * Draws only part of canvas on the LCD display.
+     * This method uses Canvas offset field as top-left point of whole canvas
+     * content. First point of specified rectangle defines the actual top-left
+     * point on the screen to be refreshed.
+     * For example, `blt({{8,0},{15,7}});` will copy canvas area {8,0}-{15,7}
+     * to screen starting at {8,0} if canvas offset is {0,0}.
+     * If canvas offset is {12,3}, then canvas area {8,0}-{15,7} will be copied
+     * to screen at position {20,3}.
+     * @param rect rectagle describing part of canvas to move to display.
+     *        Horizontal coordinates are aligned to 2 pixels.
      */
     void blt(const NanoRect &rect) override;
 };
@@ -605,6 +670,40 @@ public:
     void blt(const NanoRect &rect) override;
 };
 
+/**
+ * NanoCanvas16_1 represents objects for drawing in memory buffer
+ * NanoCanvas16_1 represents each pixel as 2-bytes with RGB bits: RRRRRGGG-GGGBBBBB,
+ * but outputs canvas to monochrome display, converting pixels with ordered dithering.
+ * This allows to render the same content for color and monochrome displays.
+ */
+class NanoCanvas16_1: public NanoCanvasBase<16>
+{
+public:
+    using NanoCanvasBase::NanoCanvasBase;
+
+    /**
+     * Draws canvas on the LCD display
+     * @param x - horizontal position in pixels
+     * @param y - vertical position in pixels (must be divided by 8)
+     */
+    void blt(lcdint_t x, lcdint_t y) override;
+
+    /**
+     * Draws canvas on the LCD display using offset values.
+     */
+    void blt() override;
+
+    /**
+     * Draws only part of canvas on the LCD display.
+     * This method uses Canvas offset field as top-left point of whole canvas
+     * content. First point of specified rectangle defines the actual top-left
+     * point on the screen to be refreshed.
+     * @param rect rectagle describing part of canvas to move to display.
+     * @note top coordinate and height of rectangle must be divided by 8.
+     */
+    void blt(const NanoRect &rect) override;
+};
+
 /**
  * @}
  */
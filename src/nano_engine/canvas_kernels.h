@@ -0,0 +1,249 @@
+/*
+    MIT License
+
+    Copyright (c) 2019, Alexey Dynda
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+/**
+ * @file canvas_kernels.h Row kernels for 8-bit and 16-bit canvas operations.
+ *
+ * @details These functions process single row of pixels and are used by NanoCanvasOps<8>
+ *          and NanoCanvasOps<16>. When the library is built for host platforms with SSE2
+ *          (x86, x86-64) or NEON (ARM) support, 16 bytes of canvas buffer are processed
+ *          at once. Other platforms use scalar implementation. Define
+ *          CONFIG_NANO_CANVAS_SIMD_DISABLE to force scalar implementation.
+ *          16-bit pixels are stored in canvas buffer in big-endian order (MSB first),
+ *          as expected by RGB displays.
+ */
+
+#ifndef _NANO_CANVAS_KERNELS_H_
+#define _NANO_CANVAS_KERNELS_H_
+
+#include "ssd1306_hal/io.h"
+#include "nano_gfx_types.h"
+
+#if !defined(CONFIG_NANO_CANVAS_SIMD_DISABLE) && !defined(ARDUINO)
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define CANVAS_SIMD_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define CANVAS_SIMD_NEON
+#endif
+#endif
+
+/** Fills count 16-bit pixels with color */
+static inline void canvas_fill16(uint8_t *dst, uint16_t color, lcduint_t count)
+{
+#if defined(CANVAS_SIMD_SSE2)
+    const __m128i vcolor = _mm_set1_epi16( (int16_t)((color >> 8) | (color << 8)) );
+    for (; count >= 8; count -= 8, dst += 16)
+    {
+        _mm_storeu_si128( (__m128i *)dst, vcolor );
+    }
+#elif defined(CANVAS_SIMD_NEON)
+    const uint8x16_t vcolor = vreinterpretq_u8_u16( vdupq_n_u16( (color >> 8) | (color << 8) ) );
+    for (; count >= 8; count -= 8, dst += 16)
+    {
+        vst1q_u8( dst, vcolor );
+    }
+#endif
+    while (count--)
+    {
+        dst[0] = color >> 8;
+        dst[1] = color & 0xFF;
+        dst += 2;
+    }
+}
+
+/**
+ * Expands single row of 1-bit bitmap (ssd1306 format: each byte is vertical 8-pixel column)
+ * to 8-bit pixels. Pixels with mask bit set get color, other pixels get black color or are
+ * left untouched in transparent mode.
+ */
+static inline void canvas_expand1_8(uint8_t *dst, const uint8_t *bitmap, lcduint_t count,
+                                    uint8_t mask, uint8_t color, bool transparent)
+{
+#if defined(CANVAS_SIMD_SSE2)
+    const __m128i vmask = _mm_set1_epi8( (int8_t)mask );
+    const __m128i vcolor = _mm_set1_epi8( (int8_t)color );
+    for (; count >= 16; count -= 16, dst += 16, bitmap += 16)
+    {
+        __m128i bits = _mm_loadu_si128( (const __m128i *)bitmap );
+        __m128i sel = _mm_cmpeq_epi8( _mm_and_si128( bits, vmask ), vmask );
+        __m128i bg = transparent ? _mm_loadu_si128( (const __m128i *)dst ) : _mm_setzero_si128();
+        _mm_storeu_si128( (__m128i *)dst,
+                          _mm_or_si128( _mm_and_si128( sel, vcolor ), _mm_andnot_si128( sel, bg ) ) );
+    }
+#elif defined(CANVAS_SIMD_NEON)
+    const uint8x16_t vmask = vdupq_n_u8( mask );
+    const uint8x16_t vcolor = vdupq_n_u8( color );
+    for (; count >= 16; count -= 16, dst += 16, bitmap += 16)
+    {
+        uint8x16_t sel = vtstq_u8( vld1q_u8( bitmap ), vmask );
+        uint8x16_t bg = transparent ? vld1q_u8( dst ) : vdupq_n_u8( 0 );
+        vst1q_u8( dst, vbslq_u8( sel, vcolor, bg ) );
+    }
+#endif
+    for (; count; count--, dst++, bitmap++)
+    {
+        if ( pgm_read_byte( bitmap ) & mask )
+            *dst = color;
+        else if (!transparent)
+            *dst = 0x00;
+    }
+}
+
+/**
+ * Expands single row of 1-bit bitmap (ssd1306 format: each byte is vertical 8-pixel column)
+ * to 16-bit pixels. Pixels with mask bit set get color, other pixels get black color or are
+ * left untouched in transparent mode.
+ */
+static inline void canvas_expand1_16(uint8_t *dst, const uint8_t *bitmap, lcduint_t count,
+                                     uint8_t mask, uint16_t color, bool transparent)
+{
+#if defined(CANVAS_SIMD_SSE2)
+    const __m128i vmask = _mm_set1_epi8( (int8_t)mask );
+    const __m128i vcolor = _mm_set1_epi16( (int16_t)((color >> 8) | (color << 8)) );
+    for (; count >= 8; count -= 8, dst += 16, bitmap += 8)
+    {
+        __m128i bits = _mm_loadl_epi64( (const __m128i *)bitmap );
+        __m128i sel = _mm_cmpeq_epi8( _mm_and_si128( bits, vmask ), vmask );
+        sel = _mm_unpacklo_epi8( sel, sel );
+        __m128i bg = transparent ? _mm_loadu_si128( (const __m128i *)dst ) : _mm_setzero_si128();
+        _mm_storeu_si128( (__m128i *)dst,
+                          _mm_or_si128( _mm_and_si128( sel, vcolor ), _mm_andnot_si128( sel, bg ) ) );
+    }
+#elif defined(CANVAS_SIMD_NEON)
+    const uint8x8_t vmask = vdup_n_u8( mask );
+    const uint8x16_t vcolor = vreinterpretq_u8_u16( vdupq_n_u16( (color >> 8) | (color << 8) ) );
+    for (; count >= 8; count -= 8, dst += 16, bitmap += 8)
+    {
+        uint8x8_t sel8 = vtst_u8( vld1_u8( bitmap ), vmask );
+        uint8x16_t sel = vcombine_u8( vzip_u8( sel8, sel8 ).val[0], vzip_u8( sel8, sel8 ).val[1] );
+        uint8x16_t bg = transparent ? vld1q_u8( dst ) : vdupq_n_u8( 0 );
+        vst1q_u8( dst, vbslq_u8( sel, vcolor, bg ) );
+    }
+#endif
+    for (; count; count--, dst += 2, bitmap++)
+    {
+        if ( pgm_read_byte( bitmap ) & mask )
+        {
+            dst[0] = color >> 8;
+            dst[1] = color & 0xFF;
+        }
+        else if (!transparent)
+        {
+            dst[0] = 0x00;
+            dst[1] = 0x00;
+        }
+    }
+}
+
+/**
+ * Copies single row of 8-bit bitmap to 8-bit pixels. In transparent mode black pixels
+ * of the bitmap are not copied.
+ */
+static inline void canvas_blit8(uint8_t *dst, const uint8_t *bitmap, lcduint_t count, bool transparent)
+{
+#if defined(CANVAS_SIMD_SSE2)
+    for (; count >= 16; count -= 16, dst += 16, bitmap += 16)
+    {
+        __m128i src = _mm_loadu_si128( (const __m128i *)bitmap );
+        if (transparent)
+        {
+            __m128i key = _mm_cmpeq_epi8( src, _mm_setzero_si128() );
+            src = _mm_or_si128( src, _mm_and_si128( key, _mm_loadu_si128( (const __m128i *)dst ) ) );
+        }
+        _mm_storeu_si128( (__m128i *)dst, src );
+    }
+#elif defined(CANVAS_SIMD_NEON)
+    for (; count >= 16; count -= 16, dst += 16, bitmap += 16)
+    {
+        uint8x16_t src = vld1q_u8( bitmap );
+        if (transparent)
+        {
+            src = vbslq_u8( vceqq_u8( src, vdupq_n_u8( 0 ) ), vld1q_u8( dst ), src );
+        }
+        vst1q_u8( dst, src );
+    }
+#endif
+    for (; count; count--, dst++, bitmap++)
+    {
+        uint8_t data = pgm_read_byte( bitmap );
+        if ( (data) || (!transparent) )
+        {
+            *dst = data;
+        }
+    }
+}
+
+/**
+ * Copies single row of 8-bit bitmap to 16-bit pixels, converting RGB8 colors to RGB16.
+ * In transparent mode black pixels of the bitmap are not copied.
+ */
+static inline void canvas_blit8to16(uint8_t *dst, const uint8_t *bitmap, lcduint_t count, bool transparent)
+{
+#if defined(CANVAS_SIMD_SSE2)
+    for (; count >= 8; count -= 8, dst += 16, bitmap += 8)
+    {
+        __m128i c = _mm_unpacklo_epi8( _mm_loadl_epi64( (const __m128i *)bitmap ), _mm_setzero_si128() );
+        __m128i color = _mm_or_si128(
+            _mm_or_si128( _mm_slli_epi16( _mm_and_si128( c, _mm_set1_epi16( 0xE0 ) ), 8 ),
+                          _mm_slli_epi16( _mm_and_si128( c, _mm_set1_epi16( 0x1C ) ), 6 ) ),
+            _mm_slli_epi16( _mm_and_si128( c, _mm_set1_epi16( 0x03 ) ), 3 ) );
+        color = _mm_or_si128( _mm_slli_epi16( color, 8 ), _mm_srli_epi16( color, 8 ) );
+        if (transparent)
+        {
+            __m128i key = _mm_cmpeq_epi16( c, _mm_setzero_si128() );
+            color = _mm_or_si128( color, _mm_and_si128( key, _mm_loadu_si128( (const __m128i *)dst ) ) );
+        }
+        _mm_storeu_si128( (__m128i *)dst, color );
+    }
+#elif defined(CANVAS_SIMD_NEON)
+    for (; count >= 8; count -= 8, dst += 16, bitmap += 8)
+    {
+        uint16x8_t c = vmovl_u8( vld1_u8( bitmap ) );
+        uint16x8_t color = vorrq_u16(
+            vorrq_u16( vshlq_n_u16( vandq_u16( c, vdupq_n_u16( 0xE0 ) ), 8 ),
+                       vshlq_n_u16( vandq_u16( c, vdupq_n_u16( 0x1C ) ), 6 ) ),
+            vshlq_n_u16( vandq_u16( c, vdupq_n_u16( 0x03 ) ), 3 ) );
+        uint8x16_t out = vrev16q_u8( vreinterpretq_u8_u16( color ) );
+        if (transparent)
+        {
+            uint8x16_t key = vreinterpretq_u8_u16( vceqq_u16( c, vdupq_n_u16( 0 ) ) );
+            out = vbslq_u8( key, vld1q_u8( dst ), out );
+        }
+        vst1q_u8( dst, out );
+    }
+#endif
+    for (; count; count--, dst += 2, bitmap++)
+    {
+        uint8_t data = pgm_read_byte( bitmap );
+        if ( (data) || (!transparent) )
+        {
+            uint16_t color = RGB8_TO_RGB16( data );
+            dst[0] = color >> 8;
+            dst[1] = color & 0xFF;
+        }
+    }
+}
+
+#endif
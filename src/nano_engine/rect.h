@@ -175,6 +175,16 @@ typedef struct _NanoRect
         return contains(r.p1) || contains(r.p2);
     }
 
+    /**
+     * Returns true if rectangles have at least one common point
+     *
+     * @param r rectangle to check
+     */
+    bool overlaps(const _NanoRect &r) const
+    {
+        return (r.p1.x <= p2.x) && (r.p2.x >= p1.x) && (r.p1.y <= p2.y) && (r.p2.y >= p1.y);
+    }
+
     /**
      * Returns true if specified point is above rectangle area.
      * @param p - point to check.
@@ -0,0 +1,184 @@
+/*
+    MIT License
+
+    Copyright (c) 2019, Alexey Dynda
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include "text_layout.h"
+#include "ssd1306.h"
+
+extern "C" SFixedFontInfo s_fixedFont;
+
+bool NanoTextLayoutBase::addLine(uint16_t start, uint16_t end, lcduint_t width)
+{
+    if ( (m_count >= m_maxLines) ||
+         ((lcdint_t)((m_count + 1) * m_lineHeight) > m_rect.height()) )
+    {
+        return false;
+    }
+    m_lines[m_count].start = start;
+    m_lines[m_count].length = end - start;
+    m_lines[m_count].width = width;
+    if ( width > m_width )
+    {
+        m_width = width;
+    }
+    m_count++;
+    return true;
+}
+
+void NanoTextLayoutBase::layout()
+{
+    m_count = 0;
+    m_width = 0;
+    m_lineHeight = s_fixedFont.h.height;
+    m_font = s_fixedFont.primary_table;
+    m_valid = true;
+    if ( !m_text || !m_lineHeight )
+    {
+        return;
+    }
+    lcduint_t maxWidth = m_rect.width();
+    bool wrap = m_flags & TEXT_WORD_WRAP;
+    uint16_t lineStart = 0;
+    uint16_t charStart = 0;
+    uint16_t pos = 0;
+    lcduint_t width = 0;
+    uint8_t lastSpacing = 0;
+    /* Position and width of the line, if it is broken at last found space */
+    uint16_t breakEnd = 0;
+    uint16_t breakNext = 0;
+    lcduint_t breakWidth = 0;
+    for (;;)
+    {
+        char c = m_text[pos];
+        if ( c == '\0' || c == '\n' )
+        {
+            if ( (c == '\0') && (pos == lineStart) && (m_count > 0) )
+            {
+                break;
+            }
+            if ( !addLine(lineStart, pos, width - lastSpacing) || (c == '\0') )
+            {
+                break;
+            }
+            pos++;
+            lineStart = charStart = pos;
+            width = lastSpacing = 0;
+            breakEnd = 0;
+            continue;
+        }
+        uint16_t unicode = ssd1306_unicode16FromUtf8(c);
+        if ( unicode == SSD1306_MORE_CHARS_REQUIRED )
+        {
+            pos++;
+            continue;
+        }
+        SCharInfo char_info;
+        ssd1306_getCharBitmap(unicode, &char_info);
+        if ( c == ' ' )
+        {
+            breakEnd = charStart;
+            breakNext = pos + 1;
+            breakWidth = width - lastSpacing;
+        }
+        else if ( wrap && (width > 0) && (width + char_info.width > maxWidth) )
+        {
+            if ( breakEnd > lineStart )
+            {
+                /* Break line at last space and measure the rest of the word again */
+                if ( !addLine(lineStart, breakEnd, breakWidth) ) break;
+                pos = breakNext;
+            }
+            else
+            {
+                /* The word doesn't fit the line, break it at current char */
+                if ( !addLine(lineStart, charStart, width - lastSpacing) ) break;
+                pos = charStart;
+            }
+            lineStart = charStart = pos;
+            width = lastSpacing = 0;
+            breakEnd = 0;
+            continue;
+        }
+        width += char_info.width + char_info.spacing;
+        lastSpacing = char_info.spacing;
+        pos++;
+        charStart = pos;
+    }
+}
+
+lcdint_t NanoTextLayoutBase::lineX(const NanoTextLine &line) const
+{
+    lcdint_t x = m_rect.p1.x;
+    if ( m_flags & TEXT_ALIGN_CENTER )
+    {
+        x += (m_rect.width() - (lcdint_t)line.width) / 2;
+    }
+    else if ( m_flags & TEXT_ALIGN_RIGHT )
+    {
+        x += m_rect.width() - (lcdint_t)line.width;
+    }
+    return x;
+}
+
+template <uint8_t BPP>
+void NanoTextLayoutBase::draw(NanoCanvasOps<BPP> &canvas)
+{
+    if ( !m_valid || m_font != s_fixedFont.primary_table || m_lineHeight != s_fixedFont.h.height )
+    {
+        layout();
+    }
+    NanoRect area = canvas.rect();
+    area.crop( m_rect );
+    if ( (area.p1.x > area.p2.x) || (area.p1.y > area.p2.y) )
+    {
+        return;
+    }
+    lcdint_t y = m_rect.p1.y;
+    for (uint8_t i = 0; i < m_count; i++, y += m_lineHeight)
+    {
+        if ( y + (lcdint_t)m_lineHeight <= area.p1.y ) continue;
+        if ( y > area.p2.y ) break;
+        const char *text = m_text + m_lines[i].start;
+        const char *end = text + m_lines[i].length;
+        lcdint_t x = lineX( m_lines[i] );
+        while ( (text < end) && (x <= area.p2.x) )
+        {
+            uint16_t unicode = ssd1306_unicode16FromUtf8(*text++);
+            if ( unicode == SSD1306_MORE_CHARS_REQUIRED ) continue;
+            SCharInfo char_info;
+            ssd1306_getCharBitmap(unicode, &char_info);
+            /* Glyphs, crossing layout rectangle borders, are clipped entirely */
+            if ( (x + (lcdint_t)char_info.width > area.p1.x) &&
+                 (x >= m_rect.p1.x) && (x + (lcdint_t)char_info.width - 1 <= m_rect.p2.x) )
+            {
+                canvas.drawGlyph(x, y, char_info);
+            }
+            x += char_info.width + char_info.spacing;
+        }
+    }
+}
+
+template void NanoTextLayoutBase::draw<1>(NanoCanvasOps<1> &canvas);
+template void NanoTextLayoutBase::draw<4>(NanoCanvasOps<4> &canvas);
+template void NanoTextLayoutBase::draw<8>(NanoCanvasOps<8> &canvas);
+template void NanoTextLayoutBase::draw<16>(NanoCanvasOps<16> &canvas);
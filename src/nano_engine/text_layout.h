@@ -0,0 +1,181 @@
+/*
+    MIT License
+
+    Copyright (c) 2019, Alexey Dynda
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+/**
+ * @file text_layout.h Text layout: word wrap, alignment and clipping
+ */
+
+#ifndef _NANO_TEXT_LAYOUT_H_
+#define _NANO_TEXT_LAYOUT_H_
+
+#include "point.h"
+#include "rect.h"
+#include "canvas.h"
+#include "ssd1306_hal/io.h"
+
+/**
+ * @ingroup NANO_ENGINE_API
+ * @{
+ */
+
+enum
+{
+    /** Lines are aligned to the left border of layout rectangle */
+    TEXT_ALIGN_LEFT             = 0x00,
+    /** Lines are centered inside layout rectangle */
+    TEXT_ALIGN_CENTER           = 0x01,
+    /** Lines are aligned to the right border of layout rectangle */
+    TEXT_ALIGN_RIGHT            = 0x02,
+    /** Lines are wrapped at spaces to fit width of layout rectangle */
+    TEXT_WORD_WRAP              = 0x04,
+};
+
+/** Describes single line of text, prepared by NanoTextLayoutBase::layout() */
+typedef struct
+{
+    uint16_t start;     ///< offset of the first byte of the line in the text
+    uint16_t length;    ///< length of the line in bytes
+    lcduint_t width;    ///< width of the line in pixels
+} NanoTextLine;
+
+/**
+ * NanoTextLayoutBase splits text into lines and draws them on canvas.
+ * Text is measured only once: line boundaries and widths are kept until text, rectangle,
+ * flags or font are changed. On every draw() call only lines and glyphs, intersecting
+ * canvas area, are processed, so in NanoEngine tiled mode text is not re-laid-out for each tile.
+ * Text is clipped to layout rectangle by whole glyphs: lines, not fitting rectangle height, and
+ * glyphs, crossing left or right border of the rectangle, are not drawn.
+ * Use NanoTextLayout template to create layout objects.
+ */
+class NanoTextLayoutBase
+{
+public:
+    /**
+     * Sets new text for the layout
+     * @param text pointer to NULL-terminated utf8 string. The string must be valid while layout is used.
+     */
+    void setText(const char *text) { m_text = text; m_valid = false; }
+
+    /**
+     * Sets new rectangle for the layout
+     * @param rect rectangle in canvas coordinates
+     */
+    void setRect(const NanoRect &rect) { m_rect = rect; m_valid = false; }
+
+    /**
+     * Sets new layout flags
+     * @param flags combination of TEXT_ALIGN_LEFT, TEXT_ALIGN_CENTER, TEXT_ALIGN_RIGHT, TEXT_WORD_WRAP
+     */
+    void setFlags(uint8_t flags) { m_flags = flags; m_valid = false; }
+
+    /** Returns layout rectangle */
+    const NanoRect &rect() const { return m_rect; }
+
+    /**
+     * Splits text into lines, using current font. Called automatically by draw(), if text,
+     * rectangle, flags or font are changed. Call it explicitly to get text metrics.
+     */
+    void layout();
+
+    /** Returns number of lines, fitting layout rectangle */
+    uint8_t lines() const { return m_count; }
+
+    /** Returns width of the widest line in pixels */
+    lcduint_t width() const { return m_width; }
+
+    /** Returns height of all lines in pixels */
+    lcduint_t height() const { return m_count * m_lineHeight; }
+
+    /**
+     * Draws text on canvas. Only glyphs, intersecting canvas area (taking into account
+     * canvas offset), are drawn.
+     * @param canvas canvas to draw text on. Color and transparency mode are taken from canvas.
+     */
+    template <uint8_t BPP>
+    void draw(NanoCanvasOps<BPP> &canvas);
+
+protected:
+    /**
+     * Creates layout object.
+     * @param lines storage for lines information
+     * @param maxLines maximum number of lines, storage can keep
+     * @param rect rectangle to layout text in
+     * @param flags combination of TEXT_ALIGN_LEFT, TEXT_ALIGN_CENTER, TEXT_ALIGN_RIGHT, TEXT_WORD_WRAP
+     */
+    NanoTextLayoutBase(NanoTextLine *lines, uint8_t maxLines, const NanoRect &rect, uint8_t flags)
+        : m_lines( lines )
+        , m_maxLines( maxLines )
+        , m_rect( rect )
+        , m_flags( flags )
+    {
+    }
+
+private:
+    NanoTextLine *m_lines;
+    uint8_t m_maxLines;
+    NanoRect m_rect;
+    uint8_t m_flags;
+    const char *m_text = nullptr;
+    const uint8_t *m_font = nullptr;
+    bool m_valid = false;
+    uint8_t m_count = 0;
+    lcduint_t m_width = 0;
+    lcduint_t m_lineHeight = 0;
+
+    bool addLine(uint16_t start, uint16_t end, lcduint_t width);
+    lcdint_t lineX(const NanoTextLine &line) const;
+};
+
+/**
+ * Text layout object, keeping information on up to MAX_LINES lines.
+ * Each line takes 4-8 bytes of RAM depending on platform.
+ *
+ * @code
+ * NanoTextLayout<4> label( {{0,0},{63,31}}, TEXT_ALIGN_CENTER | TEXT_WORD_WRAP );
+ * label.setText("Hello world!");
+ * label.draw( engine.canvas );
+ * @endcode
+ */
+template <uint8_t MAX_LINES>
+class NanoTextLayout: public NanoTextLayoutBase
+{
+public:
+    /**
+     * Creates layout object.
+     * @param rect rectangle to layout text in
+     * @param flags combination of TEXT_ALIGN_LEFT, TEXT_ALIGN_CENTER, TEXT_ALIGN_RIGHT, TEXT_WORD_WRAP
+     */
+    NanoTextLayout(const NanoRect &rect, uint8_t flags = TEXT_ALIGN_LEFT)
+        : NanoTextLayoutBase(m_storage, MAX_LINES, rect, flags)
+    {
+    }
+
+private:
+    NanoTextLine m_storage[MAX_LINES];
+};
+
+/**
+ * @}
+ */
+
+#endif
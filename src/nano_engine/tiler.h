@@ -49,7 +49,7 @@ extern "C" SFixedFontInfo s_fixedFont;
 #define TILE_128x64_MONO      NanoCanvas1,  128,    64,     7    ///< Full-screen 1-bit tile for SSD1306
 #define TILE_8x8_MONO         NanoCanvas1,  8,      8,      3    ///< Standard 1-bit tile 8x8 for monochrome mode
 #define TILE_16x16_MONO       NanoCanvas1,  16,     16,     4    ///< Standard 1-bit tile 16x16 for monochrome mode
-#define TILE_32x32_MONO       NanoCanvas1,  32,     32,     4    ///< Standard 1-bit tile 32x32 for monochrome mode
+#define TILE_32x32_MONO       NanoCanvas1,  32,     32,     5    ///< Standard 1-bit tile 32x32 for monochrome mode
 // Tiles for 8-bit displays
 #define TILE_8x8_RGB8         NanoCanvas8,  8,      8,      3    ///< Standard 8-bit RGB tile 8x8
 #define TILE_16x16_RGB8       NanoCanvas8,  16,     16,     4    ///< Standard 8-bit RGB tile 16x16
@@ -57,16 +57,63 @@ extern "C" SFixedFontInfo s_fixedFont;
 #define TILE_8x8_MONO_8       NanoCanvas1_8,8,      8,      3    ///< Standard 1-bit tile 8x8 for RGB mode
 // Tiles for 16-bit displays
 #define TILE_8x8_RGB16        NanoCanvas16, 8,      8,      3    ///< Standard 16-bit RGB tile 8x8
+// Strips: full-width bands, bits define strip height
+#define STRIP_96x8_RGB8       NanoCanvas8,  96,     8,      3    ///< 8-bit RGB strip for 96-pixel wide displays
+#define STRIP_128x8_RGB8      NanoCanvas8,  128,    8,      3    ///< 8-bit RGB strip for 128-pixel wide displays
+#define STRIP_128x8_RGB16     NanoCanvas16, 128,    8,      3    ///< 16-bit RGB strip for 128-pixel wide displays
+#define STRIP_240x8_RGB16     NanoCanvas16, 240,    8,      3    ///< 16-bit RGB strip for 240-pixel wide displays
+#define STRIP_320x8_RGB16     NanoCanvas16, 320,    8,      3    ///< 16-bit RGB strip for 320-pixel wide displays
 // Adafruit tiles
 #define ADATILE_8x8_MONO      AdafruitCanvas1,  8,  8,      3    ///< Use Adafruit GFX implementation as NanoEngine canvas
 #define ADATILE_8x8_RGB8      AdafruitCanvas8,  8,  8,      3    ///< Use Adafruit GFX implementation as NanoEngine canvas
 #define ADATILE_8x8_RGB16     AdafruitCanvas16, 8,  8,      3    ///< Use Adafruit GFX implementation as NanoEngine canvas
 
+#if defined(CONFIG_NANO_ENGINE_MERGE_TILES) && !defined(CONFIG_NANO_ENGINE_BLOCK_COST)
+/**
+ * Approximate cost of starting new display block (set_block command and interface transaction)
+ * in bytes of pixels data. Clean tiles between dirty ones are included to merged region, if
+ * sending them costs less than starting new block.
+ */
+#define CONFIG_NANO_ENGINE_BLOCK_COST   16
+#endif
+
 /**
  * Type of user-specified draw callback.
  */
 typedef bool (*TNanoEngineOnDraw)(void);
 
+/**
+ * Type of callback, setting display start line (first line of display memory, shown at the
+ * top of the screen). For example, ssd1306_setStartLine() or ssd1331_setStartLine().
+ */
+typedef void (*TNanoEngineSetStartLine)(uint8_t line);
+
+struct NanoEngineDrawable;
+
+/**
+ * Type of draw callback for objects, registered in the engine.
+ */
+typedef void (*TNanoEngineOnDrawObject)(NanoEngineDrawable &object);
+
+/**
+ * Object, registered in the engine via NanoEngineTiler::addDrawable(). The engine calls
+ * object draw callback only for tiles, the object rectangle intersects with.
+ * Objects are kept by the engine in linked list, so no memory is allocated on registration.
+ */
+struct NanoEngineDrawable
+{
+    /** Area, occupied by the object, in local screen coordinates */
+    NanoRect rect;
+    /** Callback to draw the object on engine canvas */
+    TNanoEngineOnDrawObject onDraw;
+    /** User data */
+    void *data;
+    /** Next registered object. Used by the engine */
+    NanoEngineDrawable *next;
+    /** Next object, intersecting with tiles row being drawn. Used by the engine */
+    NanoEngineDrawable *rowNext;
+};
+
 /**
  * This class template is responsible for holding and updating data about areas to be refreshed
  * on LCD display. It accepts canvas class, tile width in pixels, tile height in pixels and
@@ -75,6 +122,11 @@ typedef bool (*TNanoEngineOnDraw)(void);
  * and 3 bits means 3^2 = 8.
  * If you need to have single big buffer, holding the whole content for monochrome display,
  * you can specify something like this NanoEngineTiler<NanoCanvas1,128,64,7>.
+ * If tile width is larger than 2^bits, tiler works in strip mode: the screen is split into
+ * horizontal bands of tile width and 2^bits height, and each band is sent to the display
+ * via single address window. For example, NanoEngineTiler<NanoCanvas16,320,8,3> renders
+ * 320x240 display as 30 strips 320x8. Strip mode reduces number of set_block commands,
+ * but requires tile width to be equal to (or a divider of) display width.
  */
 template<class C, lcduint_t W, lcduint_t H, uint8_t B>
 class NanoEngineTiler
@@ -93,8 +145,19 @@ public:
     static const lcduint_t NE_TILE_WIDTH = W;
     /** Height of tile in pixels */
     static const lcduint_t NE_TILE_HEIGHT = H;
-    /** Max tiles supported in X */
+    /** Max tiles supported in Y */
     static const uint8_t NE_MAX_TILES_NUM = 64 >> (B - 3);
+#ifdef CONFIG_NANO_ENGINE_MAX_WIDTH
+    /** Number of 16-bit words, holding refresh flags for single row of tiles */
+    static const uint8_t NE_TILES_ROW_WORDS = (CONFIG_NANO_ENGINE_MAX_WIDTH / W + 15) / 16;
+#else
+    /** Number of 16-bit words, holding refresh flags for single row of tiles */
+    static const uint8_t NE_TILES_ROW_WORDS = 1;
+#endif
+    /** Max tiles supported in X */
+    static const uint8_t NE_MAX_TILES_X = NE_TILES_ROW_WORDS * 16;
+    /** True if tiler works in strip mode, i.e. tile width is larger than 2^B */
+    static const bool NE_STRIP_MODE = W > ((lcduint_t)1 << B);
 
     /** object, representing canvas. Use it in your draw handler */
     static C canvas;
@@ -104,7 +167,7 @@ public:
      */
     static void refresh()
     {
-        memset(m_refreshFlags,0xFF,sizeof(uint16_t) * NanoEngineTiler<C,W,H,B>::NE_MAX_TILES_NUM);
+        memset(m_refreshFlags,0xFF,sizeof(m_refreshFlags));
     }
 
     /**
@@ -123,8 +186,10 @@ public:
      */
     static void refresh(const NanoPoint &point)
     {
-        if ((point.y<0) || ((point.y>>B)>=NE_MAX_TILES_NUM)) return;
-        m_refreshFlags[(point.y>>B)] |= (1<<(point.x>>B));
+        if ((point.y<0) || (point.x<0) || ((point.y>>B)>=NE_MAX_TILES_NUM)) return;
+        lcdint_t x = tileColumn(point.x);
+        if (x >= NE_MAX_TILES_X) return;
+        m_refreshFlags[(point.y>>B)][x >> 4] |= (1<<(x & 0x0F));
     }
 
     /**
@@ -133,16 +198,23 @@ public:
      */
     static void refresh(lcdint_t x1, lcdint_t y1, lcdint_t x2, lcdint_t y2)
     {
-        if (y2 < 0) return;
+        if ((y2 < 0) || (x2 < 0)) return;
         if (y1 < 0) y1 = 0;
         if (x1 < 0) x1 = 0;
         y1 = y1>>B;
         y2 = min((y2>>B), NE_MAX_TILES_NUM - 1);
-        for (uint8_t y=y1; y<=y2; y++)
+        x1 = tileColumn(x1);
+        x2 = min(tileColumn(x2), NE_MAX_TILES_X - 1);
+        if ( x1 > x2 ) return;
+        /* Set range of bits word by word */
+        for (uint8_t i = x1 >> 4; i <= (x2 >> 4); i++)
         {
-            for(uint8_t x=x1>>B; x<=(x2>>B); x++)
+            uint16_t mask = 0xFFFF;
+            if ( i == (x1 >> 4) ) mask &= 0xFFFF << (x1 & 0x0F);
+            if ( i == (x2 >> 4) ) mask &= 0xFFFF >> (15 - (x2 & 0x0F));
+            for (uint8_t y=y1; y<=y2; y++)
             {
-                m_refreshFlags[y] |= (1<<x);
+                m_refreshFlags[y][i] |= mask;
             }
         }
     }
@@ -207,10 +279,41 @@ public:
     /**
      * Moves engine coordinate to new position and mark whole display for refresh
      * (this sets World coordinates offset).
+     * If hardware scroll is enabled, and position is changed only vertically by
+     * multiple of tile height, display content is shifted by display controller, and
+     * only newly exposed rows of tiles are marked for refresh.
+     * @see enableHardwareScroll()
      */
     static void moveToAndRefresh(const NanoPoint & position)
     {
+        NanoPoint delta = { (lcdint_t)(position.x - offset.x), (lcdint_t)(position.y - offset.y) };
         moveTo(position);
+        if ( !m_setStartLine || delta.x || !scrollLines(delta.y) )
+        {
+            refresh();
+        }
+    }
+
+    /**
+     * Enables vertical panning, using display start line. When enabled, moveToAndRefresh()
+     * shifts display content with display controller instead of redrawing whole screen,
+     * and the engine sends tiles to display memory rows, shifted by current start line.
+     * Display height must be equal to height of display controller memory (for example,
+     * 128x64 ssd1306 or 96x64 ssd1331 in default rotation) and multiple of tile height.
+     * @warning Do not use direct draw functions, while hardware scroll is enabled, since
+     *          they do not take start line into account.
+     * @param handler function to set display start line, for example, ssd1306_setStartLine.
+     *        nullptr disables hardware scroll.
+     */
+    static void enableHardwareScroll(TNanoEngineSetStartLine handler)
+    {
+        if (m_setStartLine || handler)
+        {
+            m_startLine = 0;
+            if (handler) handler(0);
+            else m_setStartLine(0);
+        }
+        m_setStartLine = handler;
         refresh();
     }
 
@@ -226,7 +329,7 @@ public:
      * Sets user-defined draw callback. This callback will be called everytime, engine needs
      * to update display content. If callback returns false, engine will not update those area.
      * You always have a way to find out, which area is being updated by engine via
-     * NanoEngine<>::canvas::getOffset() and NanoEngine<>::NE_TILE_SIZE.
+     * tileRect() or NanoEngine<>::canvas::getOffset() and NanoEngine<>::NE_TILE_SIZE.
      * @warning   By default canvas in the engine is initialized with local screen coordinates. So
      *            graphics object with [0,0] coordinates will be placed at topleft position on the
      *            display. But engine supports also global coordinates, in this case actual object
@@ -251,16 +354,85 @@ public:
      */
     static bool collision(NanoPoint &p, NanoRect &rect) { return rect.collision( p ); }
 
+    /**
+     * Returns rectangle of the tile, being drawn, in local screen coordinates.
+     * Use it in draw callback to skip objects, which do not intersect the tile.
+     */
+    static const NanoRect & tileRect() { return m_tileRect; }
+
+    /**
+     * Returns true if rectangle in local screen coordinates intersects the tile, being drawn.
+     * @param rect rectangle to check
+     */
+    static bool tileIntersects(const NanoRect &rect) { return m_tileRect.overlaps( rect ); }
+
+    /**
+     * Registers object to draw. For each refreshed tile the engine calls draw callback,
+     * set by drawCallback(), and then draw callbacks of registered objects, intersecting the
+     * tile, in order of registration. If there is no draw callback, the engine clears the
+     * canvas before drawing objects. Canvas is switched to local coordinates before calling
+     * object callback. Object rectangle can be changed at any time, but it is up to
+     * application to mark old and new object areas for refresh.
+     * @param object object to register. The object must exist until it is removed from the engine.
+     */
+    static void addDrawable(NanoEngineDrawable &object)
+    {
+        object.next = nullptr;
+        NanoEngineDrawable **p = &m_drawables;
+        while (*p) p = &(*p)->next;
+        *p = &object;
+    }
+
+    /**
+     * Removes object from the engine.
+     * @param object object to remove
+     */
+    static void removeDrawable(NanoEngineDrawable &object)
+    {
+        for (NanoEngineDrawable **p = &m_drawables; *p; p = &(*p)->next)
+        {
+            if (*p == &object)
+            {
+                *p = object.next;
+                break;
+            }
+        }
+    }
+
+#ifdef CONFIG_NANO_ENGINE_TILE_HASH_ENABLE
+    /**
+     * Forgets content of all tiles, sent to the display. Next display() call will send all
+     * refreshed tiles to the display even if their content is not changed.
+     * Call this method if display content was modified bypassing the engine.
+     */
+    static void resetTileHashes()
+    {
+        memset(m_tileHash, 0, sizeof(m_tileHash));
+    }
+#endif
+
 protected:
     /**
      * Contains information on tiles to be updated.
-     * Elements of array are rows and bits are columns.
+     * Elements of array are rows and bits of row words are columns.
      */
-    static uint16_t   m_refreshFlags[NE_MAX_TILES_NUM];
+    static uint16_t   m_refreshFlags[NE_MAX_TILES_NUM][NE_TILES_ROW_WORDS];
 
     /** Callback to call if specific tile needs to be updated */
     static TNanoEngineOnDraw m_onDraw;
 
+    /** Callback to set display start line. nullptr if hardware scroll is disabled */
+    static TNanoEngineSetStartLine m_setStartLine;
+
+    /** Display memory row, shown at the top of the screen */
+    static lcduint_t m_startLine;
+
+    /** List of registered objects */
+    static NanoEngineDrawable *m_drawables;
+
+    /** Rectangle of the tile, being drawn, in local screen coordinates */
+    static NanoRect m_tileRect;
+
     /**
      * @brief refreshes content on oled display.
      * Refreshes content on oled display. Call it, if you want to update the screen.
@@ -279,11 +451,91 @@ private:
     /** Buffer, used by NanoCanvas */
     static uint8_t    m_buffer[W * H * C::BITS_PER_PIXEL / 8];
 
+#ifdef CONFIG_NANO_ENGINE_TILE_HASH_ENABLE
+    /** Hashes of tiles content, which was sent to the display. 0 means unknown content */
+    static uint32_t   m_tileHash[NE_MAX_TILES_NUM][NE_MAX_TILES_X];
+#endif
+
     static NanoPoint offset;
+
+    /**
+     * Returns true if canvas content differs from the content, last sent to the
+     * display for the tile at position (x,y), and remembers new content.
+     * Always returns true if CONFIG_NANO_ENGINE_TILE_HASH_ENABLE is not defined.
+     */
+    static bool tileChanged(lcduint_t x, lcduint_t y);
+
+    /** Returns index of tile column for x position in pixels */
+    static lcdint_t tileColumn(lcdint_t x)
+    {
+        return NE_STRIP_MODE ? x / NE_TILE_WIDTH : x >> B;
+    }
+
+    /**
+     * Links registered objects, intersecting tiles row at y, via rowNext field
+     * and returns the first one.
+     */
+    static NanoEngineDrawable *rowDrawables(lcduint_t y);
+
+    /**
+     * Calls draw callback and draw callbacks of objects from row list, intersecting
+     * the tile at (x,y). Returns false if the tile must not be sent to the display.
+     */
+    static bool drawTile(NanoEngineDrawable *row, lcduint_t x, lcduint_t y);
+
+    /**
+     * Copies refresh flags of tiles row at y to flags and clears them.
+     * Returns false if no tile in the row needs to be updated.
+     */
+    static bool takeRow(lcduint_t y, uint16_t *flags);
+
+    /** Returns display memory row, shown at screen row y */
+    static lcduint_t memoryRow(lcduint_t y)
+    {
+        return m_setStartLine ? (y + m_startLine) % ssd1306_lcd.height : y;
+    }
+
+    /** Sends canvas content to the display for the tile at screen position (x,y) */
+    static void sendTile(lcdint_t x, lcduint_t y)
+    {
+        lcduint_t top = memoryRow(y);
+        lcduint_t split = ssd1306_lcd.height - top;
+        canvas.setOffset(x, top);
+        if ( !m_setStartLine || (split >= H) )
+        {
+            canvas.blt();
+            return;
+        }
+        /* Canvas lines below the end of display memory are shown from its first line */
+        canvas.blt( { {0, 0}, {(lcdint_t)W - 1, (lcdint_t)split - 1} } );
+        canvas.setOffset(x, -(lcdint_t)split);
+        canvas.blt( { {0, (lcdint_t)split}, {(lcdint_t)W - 1, (lcdint_t)H - 1} } );
+    }
+
+    /**
+     * Shifts display content by dy lines via display start line, and moves refresh flags
+     * accordingly. Returns false if content cannot be shifted by hardware.
+     */
+    static bool scrollLines(lcdint_t dy);
+
+#ifdef CONFIG_NANO_ENGINE_MERGE_TILES
+    /** Buffer, holding pixels of merged region */
+    static uint8_t    m_region[CONFIG_NANO_ENGINE_MERGE_TILES * W * H * C::BITS_PER_PIXEL / 8];
+
+    /**
+     * Draws tiles from first to last column of tiles row at y to region buffer and sends
+     * them to the display as single block. Returns column of the tile, which draw callback
+     * refused to draw, or -1 if whole region is processed.
+     */
+    static lcdint_t displayRegion(NanoEngineDrawable *row, lcduint_t y, lcdint_t first, lcdint_t last);
+
+    /** Splits tiles row into merged regions and sends them to the display */
+    static void displayRegions(NanoEngineDrawable *row, lcduint_t y, const uint16_t *flags);
+#endif
 };
 
 template<class C, lcduint_t W, lcduint_t H, uint8_t B>
-uint16_t NanoEngineTiler<C,W,H,B>::m_refreshFlags[NE_MAX_TILES_NUM];
+uint16_t NanoEngineTiler<C,W,H,B>::m_refreshFlags[NE_MAX_TILES_NUM][NE_TILES_ROW_WORDS];
 
 template<class C, lcduint_t W, lcduint_t H, uint8_t B>
 uint8_t NanoEngineTiler<C,W,H,B>::m_buffer[W * H * C::BITS_PER_PIXEL / 8];
@@ -291,37 +543,278 @@ uint8_t NanoEngineTiler<C,W,H,B>::m_buffer[W * H * C::BITS_PER_PIXEL / 8];
 template<class C, lcduint_t W, lcduint_t H, uint8_t B>
 C NanoEngineTiler<C,W,H,B>::canvas(W, H, m_buffer);
 
+#ifdef CONFIG_NANO_ENGINE_TILE_HASH_ENABLE
+template<class C, lcduint_t W, lcduint_t H, uint8_t B>
+uint32_t NanoEngineTiler<C,W,H,B>::m_tileHash[NE_MAX_TILES_NUM][NE_MAX_TILES_X];
+#endif
+
 template<class C, lcduint_t W, lcduint_t H, uint8_t B>
 NanoPoint NanoEngineTiler<C,W,H,B>::offset = {0, 0};
 
 template<class C, lcduint_t W, lcduint_t H, uint8_t B>
 TNanoEngineOnDraw NanoEngineTiler<C,W,H,B>::m_onDraw = nullptr;
 
+#ifdef CONFIG_NANO_ENGINE_MERGE_TILES
+template<class C, lcduint_t W, lcduint_t H, uint8_t B>
+uint8_t NanoEngineTiler<C,W,H,B>::m_region[CONFIG_NANO_ENGINE_MERGE_TILES * W * H * C::BITS_PER_PIXEL / 8];
+#endif
+
+template<class C, lcduint_t W, lcduint_t H, uint8_t B>
+NanoEngineDrawable *NanoEngineTiler<C,W,H,B>::m_drawables = nullptr;
+
+template<class C, lcduint_t W, lcduint_t H, uint8_t B>
+TNanoEngineSetStartLine NanoEngineTiler<C,W,H,B>::m_setStartLine = nullptr;
+
+template<class C, lcduint_t W, lcduint_t H, uint8_t B>
+lcduint_t NanoEngineTiler<C,W,H,B>::m_startLine = 0;
+
+template<class C, lcduint_t W, lcduint_t H, uint8_t B>
+NanoRect NanoEngineTiler<C,W,H,B>::m_tileRect = { {0, 0}, {W - 1, H - 1} };
+
+template<class C, lcduint_t W, lcduint_t H, uint8_t B>
+bool NanoEngineTiler<C,W,H,B>::tileChanged(lcduint_t x, lcduint_t y)
+{
+#ifdef CONFIG_NANO_ENGINE_TILE_HASH_ENABLE
+    /* FNV-1a hash of the tile content */
+    uint32_t hash = 2166136261UL;
+    for (const uint8_t *p = m_buffer; p < m_buffer + sizeof(m_buffer); p++)
+    {
+        hash = (hash ^ *p) * 16777619UL;
+    }
+    if (!hash) hash = 1;
+    uint32_t &last = m_tileHash[y >> NE_TILE_SIZE_BITS][tileColumn(x)];
+    if (last == hash)
+    {
+        return false;
+    }
+    last = hash;
+#endif
+    return true;
+}
+
+template<class C, lcduint_t W, lcduint_t H, uint8_t B>
+NanoEngineDrawable *NanoEngineTiler<C,W,H,B>::rowDrawables(lcduint_t y)
+{
+    NanoEngineDrawable *first = nullptr;
+    NanoEngineDrawable **last = &first;
+    for (NanoEngineDrawable *p = m_drawables; p; p = p->next)
+    {
+        if ( (p->rect.p1.y <= (lcdint_t)(y + NE_TILE_HEIGHT - 1)) && (p->rect.p2.y >= (lcdint_t)y) )
+        {
+            *last = p;
+            last = &p->rowNext;
+        }
+    }
+    *last = nullptr;
+    return first;
+}
+
+template<class C, lcduint_t W, lcduint_t H, uint8_t B>
+bool NanoEngineTiler<C,W,H,B>::drawTile(NanoEngineDrawable *row, lcduint_t x, lcduint_t y)
+{
+    m_tileRect = { {(lcdint_t)x, (lcdint_t)y},
+                   {(lcdint_t)(x + NE_TILE_WIDTH - 1), (lcdint_t)(y + NE_TILE_HEIGHT - 1)} };
+    canvas.setOffset(x, y);
+    if (!m_onDraw)
+    {
+        // Without draw callback nobody erases content of previous tile
+        canvas.clear();
+    }
+    else if (!m_onDraw())
+    {
+        return false;
+    }
+    canvas.setOffset(x, y);
+    for (; row; row = row->rowNext)
+    {
+        if ( (row->rect.p1.x <= m_tileRect.p2.x) && (row->rect.p2.x >= m_tileRect.p1.x) )
+        {
+            row->onDraw( *row );
+            canvas.setOffset(x, y);
+        }
+    }
+    return true;
+}
+
+template<class C, lcduint_t W, lcduint_t H, uint8_t B>
+bool NanoEngineTiler<C,W,H,B>::scrollLines(lcdint_t dy)
+{
+    const lcdint_t height = ssd1306_lcd.height;
+    const lcdint_t rows = height / (lcdint_t)NE_TILE_HEIGHT;
+    const lcdint_t shift = dy / (lcdint_t)NE_TILE_HEIGHT;
+    if ( (dy % (lcdint_t)NE_TILE_HEIGHT) || (height % (lcdint_t)NE_TILE_HEIGHT) ||
+         (rows > NE_MAX_TILES_NUM) || (shift >= rows) || (-shift >= rows) )
+    {
+        return false;
+    }
+    if ( !shift )
+    {
+        return true;
+    }
+    m_startLine = (m_startLine + height + dy % height) % height;
+    m_setStartLine( m_startLine );
+    /* Content of screen row r is now shown at row r - shift. Newly exposed rows need to be drawn */
+    for (lcdint_t i = 0; i < rows; i++)
+    {
+        lcdint_t r = shift > 0 ? i : rows - 1 - i;
+        lcdint_t src = r + shift;
+        if ( (src >= 0) && (src < rows) )
+        {
+            memcpy(m_refreshFlags[r], m_refreshFlags[src], sizeof(m_refreshFlags[0]));
+#ifdef CONFIG_NANO_ENGINE_TILE_HASH_ENABLE
+            memcpy(m_tileHash[r], m_tileHash[src], sizeof(m_tileHash[0]));
+#endif
+        }
+        else
+        {
+            memset(m_refreshFlags[r], 0xFF, sizeof(m_refreshFlags[0]));
+#ifdef CONFIG_NANO_ENGINE_TILE_HASH_ENABLE
+            memset(m_tileHash[r], 0, sizeof(m_tileHash[0]));
+#endif
+        }
+    }
+    return true;
+}
+
+template<class C, lcduint_t W, lcduint_t H, uint8_t B>
+bool NanoEngineTiler<C,W,H,B>::takeRow(lcduint_t y, uint16_t *flags)
+{
+    uint16_t *row = m_refreshFlags[y >> NE_TILE_SIZE_BITS];
+    uint16_t changed = 0;
+    for (uint8_t i = 0; i < NE_TILES_ROW_WORDS; i++)
+    {
+        flags[i] = row[i];
+        changed |= row[i];
+        row[i] = 0;
+    }
+    return changed != 0;
+}
+
+#ifdef CONFIG_NANO_ENGINE_MERGE_TILES
+template<class C, lcduint_t W, lcduint_t H, uint8_t B>
+lcdint_t NanoEngineTiler<C,W,H,B>::displayRegion(NanoEngineDrawable *row, lcduint_t y, lcdint_t first, lcdint_t last)
+{
+    /* 1-bit canvases keep pixels as pages of 8 rows, other canvases keep them row by row */
+    const lcduint_t rows = C::BITS_PER_PIXEL == 1 ? (H >> 3) : H;
+    const lcduint_t rowBytes = sizeof(m_buffer) / rows;
+    const lcduint_t pitch = rowBytes * (last - first + 1);
+    C region( (last - first + 1) * W, H, m_region );
+    bool changed = false;
+    for (lcdint_t column = first; column <= last; column++)
+    {
+        if ( !drawTile(row, column * W, y) )
+        {
+#ifdef CONFIG_NANO_ENGINE_TILE_HASH_ENABLE
+            /* Tiles, drawn before, are not sent yet */
+            for (lcdint_t i = first; i < column; i++)
+            {
+                m_tileHash[y >> NE_TILE_SIZE_BITS][i] = 0;
+            }
+#endif
+            return column;
+        }
+        canvas.setOffset(column * W, y);
+        if ( tileChanged(column * W, y) )
+        {
+            changed = true;
+        }
+        uint8_t *dst = m_region + (column - first) * rowBytes;
+        for (lcduint_t i = 0; i < rows; i++)
+        {
+            memcpy( dst + i * pitch, m_buffer + i * rowBytes, rowBytes );
+        }
+    }
+    if ( changed )
+    {
+        region.setOffset(first * W, memoryRow(y));
+        region.blt();
+    }
+    return -1;
+}
+
+template<class C, lcduint_t W, lcduint_t H, uint8_t B>
+void NanoEngineTiler<C,W,H,B>::displayRegions(NanoEngineDrawable *row, lcduint_t y, const uint16_t *flags)
+{
+    lcdint_t columns = (ssd1306_lcd.width + W - 1) / W;
+    if ( columns > NE_MAX_TILES_X ) columns = NE_MAX_TILES_X;
+    lcdint_t first = -1;
+    lcdint_t last = -1;
+    for (lcdint_t column = 0; column <= columns; column++)
+    {
+        if ( (column < columns) && !(flags[column >> 4] & (1 << (column & 0x0F))) )
+        {
+            continue;
+        }
+        /* Merge dirty tile to current region if region is not full yet and sending clean tiles
+           between them costs less than starting new block */
+        if ( (column < columns) && (first >= 0) && (column - first < CONFIG_NANO_ENGINE_MERGE_TILES) &&
+             ((uint32_t)(column - last - 1) * sizeof(m_buffer) <= CONFIG_NANO_ENGINE_BLOCK_COST) )
+        {
+            last = column;
+            continue;
+        }
+        while ( first >= 0 )
+        {
+            lcdint_t refused = displayRegion(row, y, first, last);
+            if ( refused < 0 )
+            {
+                break;
+            }
+            /* Draw callback refused to draw tile: send tiles before and after it separately */
+            if ( refused > first )
+            {
+                displayRegion(row, y, first, refused - 1);
+            }
+            first = refused < last ? refused + 1 : -1;
+        }
+        first = last = column;
+    }
+}
+#endif
+
 template<class C, lcduint_t W, lcduint_t H, uint8_t B>
 void NanoEngineTiler<C,W,H,B>::displayBuffer()
 {
-    if (!m_onDraw)  // If onDraw handler is not set, just output current canvas
+    if (!m_onDraw && !m_drawables)  // If nothing to draw, just output current canvas
     {
-        canvas.blt();
+#ifdef CONFIG_NANO_ENGINE_TILE_HASH_ENABLE
+        resetTileHashes();
+#endif
+        NanoPoint position = canvas.offset;
+        if ( (position.y >= 0) && (position.y < (lcdint_t)ssd1306_lcd.height) )
+        {
+            sendTile(position.x, position.y);
+            canvas.offset = position;
+        }
+        else
+        {
+            canvas.blt();
+        }
         return;
     }
-    for (lcduint_t y = 0; y < ssd1306_lcd.height; y = y + NE_TILE_HEIGHT)
+    uint16_t flags[NE_TILES_ROW_WORDS];
+    for (lcduint_t y = 0; (y < ssd1306_lcd.height) && ((y >> B) < NE_MAX_TILES_NUM); y = y + NE_TILE_HEIGHT)
     {
-        uint16_t flag = m_refreshFlags[y >> NE_TILE_SIZE_BITS];
-        m_refreshFlags[y >> NE_TILE_SIZE_BITS] = 0;
-        for (lcduint_t x = 0; x < ssd1306_lcd.width; x = x + NE_TILE_WIDTH)
+        if (!takeRow(y, flags)) continue;
+        NanoEngineDrawable *row = rowDrawables(y);
+#ifdef CONFIG_NANO_ENGINE_MERGE_TILES
+        displayRegions(row, y, flags);
+#else
+        uint8_t column = 0;
+        for (lcduint_t x = 0; (x < ssd1306_lcd.width) && (column < NE_MAX_TILES_X); x = x + NE_TILE_WIDTH, column++)
         {
-            if (flag & 0x01)
+            if (flags[column >> 4] & (1 << (column & 0x0F)))
             {
-                canvas.setOffset(x, y);
-                if (m_onDraw())
+                if (drawTile(row, x, y))
                 {
-                    canvas.setOffset(x, y);
-                    canvas.blt();
+                    if (tileChanged(x, y))
+                    {
+                        sendTile(x, y);
+                    }
                 }
             }
-            flag >>=1;
         }
+#endif
     }
 }
 
@@ -332,16 +825,17 @@ void NanoEngineTiler<C,W,H,B>::displayPopup(const char *msg)
     // TODO: It would be nice to calculate message height
     NanoPoint textPos = { (ssd1306_lcd.width - (lcdint_t)strlen(msg)*s_fixedFont.h.width) >> 1, (ssd1306_lcd.height>>1) - 4 };
     refresh(rect);
-    for (lcduint_t y = 0; y < ssd1306_lcd.height; y = y + NE_TILE_HEIGHT)
+    uint16_t flags[NE_TILES_ROW_WORDS];
+    for (lcduint_t y = 0; (y < ssd1306_lcd.height) && ((y >> B) < NE_MAX_TILES_NUM); y = y + NE_TILE_HEIGHT)
     {
-        uint16_t flag = m_refreshFlags[y >> NE_TILE_SIZE_BITS];
-        m_refreshFlags[y >> NE_TILE_SIZE_BITS] = 0;
-        for (lcduint_t x = 0; x < ssd1306_lcd.width; x = x + NE_TILE_WIDTH)
+        if (!takeRow(y, flags)) continue;
+        NanoEngineDrawable *row = rowDrawables(y);
+        uint8_t column = 0;
+        for (lcduint_t x = 0; (x < ssd1306_lcd.width) && (column < NE_MAX_TILES_X); x = x + NE_TILE_WIDTH, column++)
         {
-            if (flag & 0x01)
+            if (flags[column >> 4] & (1 << (column & 0x0F)))
             {
-                canvas.setOffset(x, y);
-                if (m_onDraw) m_onDraw();
+                drawTile(row, x, y);
                 canvas.setOffset(x, y);
                 canvas.setColor(RGB_COLOR8(0,0,0));
                 canvas.fillRect(rect);
@@ -349,9 +843,11 @@ void NanoEngineTiler<C,W,H,B>::displayPopup(const char *msg)
                 canvas.drawRect(rect);
                 canvas.printFixed( textPos.x, textPos.y, msg);
 
-                canvas.blt();
+                if (tileChanged(x, y))
+                {
+                    sendTile(x, y);
+                }
             }
-            flag >>=1;
         }
     }
 }
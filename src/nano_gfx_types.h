@@ -82,6 +82,9 @@ typedef enum
     FONT_SIZE_8X     = 3,
 } EFontSize;
 
+/** Type of free fonts with RLE compressed glyphs (refer to ssd1306_rle.h) */
+#define SSD1306_RLE_FONT_TYPE  0x04
+
 #pragma pack(push, 1)
 /** Structure describes font format in memory */
 typedef struct
@@ -34,6 +34,8 @@
 #include "ssd1306_8bit.h"
 #include "ssd1306_16bit.h"
 #include "ssd1306_fonts.h"
+#include "ssd1306_rle.h"
+#include "ssd1306_convert.h"
 
 #include "lcd/lcd_common.h"
 #include "lcd/oled_ssd1306.h"
@@ -48,6 +50,7 @@
 #include "lcd/composite_video.h"
 
 #include "lcd/oled_template.h"
+#include "lcd/linux_fb.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -24,6 +24,7 @@
 
 #include "ssd1306_16bit.h"
 #include "ssd1306_generic.h"
+#include "ssd1306_rle.h"
 #include "intf/ssd1306_interface.h"
 #include "lcd/lcd_common.h"
 #include "ssd1306_hal/io.h"
@@ -42,18 +43,63 @@ void    ssd1306_setRgbColor16(uint8_t r, uint8_t g, uint8_t b)
     ssd1306_color = RGB_COLOR16(r,g,b);
 }
 
+static void ssd1306_sendColor16(uint16_t color, uint32_t count)
+{
+    if ( ssd1306_lcd.send_pixels_buffer16 )
+    {
+        uint8_t chunk[32];
+        for (uint8_t i = 0; i < sizeof(chunk); i += 2)
+        {
+            chunk[i] = color >> 8;
+            chunk[i + 1] = color & 0xFF;
+        }
+        while (count)
+        {
+            uint8_t len = count < (sizeof(chunk) >> 1) ? count : (sizeof(chunk) >> 1);
+            ssd1306_lcd.send_pixels_buffer16( chunk, len << 1 );
+            count -= len;
+        }
+        return;
+    }
+    while (count--)
+    {
+        ssd1306_lcd.send_pixels16( color );
+    }
+}
+
 static void ssd1306_drawBufferPitch16(lcdint_t x, lcdint_t y, lcduint_t w, lcduint_t h, lcduint_t pitch, const uint8_t *data)
 {
     ssd1306_lcd.set_block(x, y, w);
-    while (h--)
+    if ( !ssd1306_lcd.send_pixels_buffer16 )
+    {
+        while (h--)
+        {
+            for (lcduint_t i = 0; i < w; i++)
+            {
+                ssd1306_lcd.send_pixels16( (data[2*i] << 8) | data[2*i + 1] );
+            }
+            data += pitch;
+        }
+    }
+    else if ( pitch == (w << 1) )
     {
-        lcduint_t line = w << 1;
-        while (line--)
+        /* Lines follow each other: send the whole block as long bursts */
+        uint32_t size = (uint32_t)pitch * h;
+        while (size)
         {
-            ssd1306_intf.send( *data );
-            data++;
+            uint16_t len = size > 0x8000 ? 0x8000 : size;
+            ssd1306_lcd.send_pixels_buffer16( data, len );
+            data += len;
+            size -= len;
+        }
+    }
+    else
+    {
+        while (h--)
+        {
+            ssd1306_lcd.send_pixels_buffer16( data, w << 1 );
+            data += pitch;
         }
-        data += pitch - (w << 1);
     }
     ssd1306_intf.stop();
 }
@@ -71,11 +117,51 @@ void ssd1306_drawBufferEx16(lcdint_t x, lcdint_t y, lcduint_t w, lcduint_t h, lc
 // IMPORTANT: ALL 16-BIT OLED DISPLAYS ALSO SUPPORT 8-BIT DIRECT DRAW FUNCTIONS
 //            REFER TO ssd1306_8bit.c
 
+// Rows of the bitmap are expanded by table lookups to RGB16 chunks, which are sent as single buffer
+static void ssd1306_drawMonoBufferFast16(lcdint_t xpos, lcdint_t ypos, lcduint_t w, lcduint_t h,
+                                         const uint8_t *bitmap, uint16_t color, uint16_t blackColor)
+{
+    uint8_t chunk[32];
+    const uint8_t colors[2][2] = { { blackColor >> 8, blackColor & 0xFF }, { color >> 8, color & 0xFF } };
+    uint8_t row = 0;
+    ssd1306_lcd.set_block(xpos, ypos, w);
+    while (h--)
+    {
+        uint8_t n = 0;
+        for (lcduint_t i = 0; i < w; i++)
+        {
+            const uint8_t *c = colors[(bitmap[i] >> row) & 0x01];
+            chunk[n++] = c[0];
+            chunk[n++] = c[1];
+            if ( n == sizeof(chunk) )
+            {
+                ssd1306_lcd.send_pixels_buffer16( chunk, n );
+                n = 0;
+            }
+        }
+        if ( n )
+        {
+            ssd1306_lcd.send_pixels_buffer16( chunk, n );
+        }
+        if ( ++row == 8 )
+        {
+            row = 0;
+            bitmap += w;
+        }
+    }
+    ssd1306_intf.stop();
+}
+
 void ssd1306_drawMonoBuffer16(lcdint_t xpos, lcdint_t ypos, lcduint_t w, lcduint_t h, const uint8_t *bitmap)
 {
     uint8_t bit = 1;
     uint16_t blackColor = s_ssd1306_invertByte ? ssd1306_color : 0x00;
     uint16_t color = s_ssd1306_invertByte ? 0x00 : ssd1306_color;
+    if ( ssd1306_lcd.send_pixels_buffer16 )
+    {
+        ssd1306_drawMonoBufferFast16(xpos, ypos, w, h, bitmap, color, blackColor);
+        return;
+    }
     ssd1306_lcd.set_block(xpos, ypos, w);
     while (h--)
     {
@@ -104,12 +190,13 @@ void ssd1306_drawMonoBuffer16(lcdint_t xpos, lcdint_t ypos, lcduint_t w, lcduint
 
 void ssd1306_fillScreen16(uint16_t fill_Data)
 {
-    ssd1306_lcd.set_block(0, 0, 0);
-    uint32_t count = (uint32_t)ssd1306_lcd.width * (uint32_t)ssd1306_lcd.height;
-    while (count--)
+    if ( ssd1306_lcd.fill_rect &&
+         ssd1306_lcd.fill_rect(0, 0, ssd1306_lcd.width - 1, ssd1306_lcd.height - 1, fill_Data) )
     {
-        ssd1306_lcd.send_pixels16( fill_Data );
+        return;
     }
+    ssd1306_lcd.set_block(0, 0, 0);
+    ssd1306_sendColor16( fill_Data, (uint32_t)ssd1306_lcd.width * (uint32_t)ssd1306_lcd.height );
     ssd1306_intf.stop();
 }
 
@@ -156,6 +243,10 @@ void ssd1306_drawHLine16(lcdint_t x1, lcdint_t y1, lcdint_t x2)
 
 void ssd1306_drawLine16(lcdint_t x1, lcdint_t y1, lcdint_t x2, lcdint_t y2)
 {
+    if ( ssd1306_lcd.draw_line && ssd1306_lcd.draw_line(x1, y1, x2, y2, ssd1306_color) )
+    {
+        return;
+    }
     lcduint_t  dx = x1 > x2 ? (x1 - x2): (x2 - x1);
     lcduint_t  dy = y1 > y2 ? (y1 - y2): (y2 - y1);
     lcduint_t  err = 0;
@@ -215,12 +306,12 @@ void ssd1306_fillRect16(lcdint_t x1, lcdint_t y1, lcdint_t x2, lcdint_t y2)
     {
         ssd1306_swap_data(x1, x2, lcdint_t);
     }
-    ssd1306_lcd.set_block(x1, y1, x2 - x1 + 1);
-    uint16_t count = (x2 - x1 + 1) * (y2 - y1 + 1);
-    while (count--)
+    if ( ssd1306_lcd.fill_rect && ssd1306_lcd.fill_rect(x1, y1, x2, y2, ssd1306_color) )
     {
-        ssd1306_lcd.send_pixels16( ssd1306_color );
+        return;
     }
+    ssd1306_lcd.set_block(x1, y1, x2 - x1 + 1);
+    ssd1306_sendColor16( ssd1306_color, (uint16_t)((x2 - x1 + 1) * (y2 - y1 + 1)) );
     ssd1306_intf.stop();
 }
 
@@ -255,6 +346,54 @@ void ssd1306_drawMonoBitmap16(lcdint_t xpos, lcdint_t ypos, lcduint_t w, lcduint
     ssd1306_intf.stop();
 }
 
+void ssd1306_drawRleMonoBitmap16(lcdint_t xpos, lcdint_t ypos, lcduint_t w, lcduint_t h, const uint8_t *bitmap)
+{
+    /* Bitmap is decoded by vertical strips, so glyphs up to 32 pixels wide are sent as single block */
+    uint8_t chunk[32];
+    SRleDecoder rle;
+    uint16_t blackColor = s_ssd1306_invertByte ? ssd1306_color : 0x00;
+    uint16_t color = s_ssd1306_invertByte ? 0x00 : ssd1306_color;
+    ssd1306_rleInit(&rle, bitmap);
+    while (h)
+    {
+        uint8_t rows = h < 8 ? h : 8;
+        lcduint_t x = 0;
+        while (x < w)
+        {
+            uint8_t n = (w - x) < sizeof(chunk) ? (w - x) : sizeof(chunk);
+            ssd1306_rleRead(&rle, chunk, n);
+            ssd1306_lcd.set_block(xpos + x, ypos, n);
+            for (uint8_t row = 0; row < rows; row++)
+            {
+                uint8_t bit = 1 << row;
+                for (uint8_t i = 0; i < n; i++)
+                {
+                    if ( chunk[i] & bit )
+                        ssd1306_lcd.send_pixels16( color );
+                    else
+                        ssd1306_lcd.send_pixels16( blackColor );
+                }
+            }
+            ssd1306_intf.stop();
+            x += n;
+        }
+        ypos += rows;
+        h -= rows;
+    }
+}
+
+void ssd1306_drawGlyph16(lcdint_t x, lcdint_t y, const SCharInfo *char_info)
+{
+    if ( s_fixedFont.h.type == SSD1306_RLE_FONT_TYPE )
+    {
+        ssd1306_drawRleMonoBitmap16(x, y, char_info->width, char_info->height, char_info->glyph);
+    }
+    else
+    {
+        ssd1306_drawMonoBitmap16(x, y, char_info->width, char_info->height, char_info->glyph);
+    }
+}
+
 void ssd1306_drawBitmap16(lcdint_t xpos, lcdint_t ypos, lcduint_t w, lcduint_t h, const uint8_t *bitmap)
 {
     ssd1306_lcd.set_block(xpos, ypos, w);
@@ -269,12 +408,13 @@ void ssd1306_drawBitmap16(lcdint_t xpos, lcdint_t ypos, lcduint_t w, lcduint_t h
 
 void ssd1306_clearBlock16(uint8_t x, uint8_t y, uint8_t w, uint8_t h)
 {
-    ssd1306_lcd.set_block(x, y, w);
-    uint32_t count = w * h;
-    while (count--)
+    if ( w && h && ssd1306_lcd.fill_rect &&
+         ssd1306_lcd.fill_rect(x, y, x + w - 1, y + h - 1, 0) )
     {
-        ssd1306_lcd.send_pixels16( 0x0000 );
+        return;
     }
+    ssd1306_lcd.set_block(x, y, w);
+    ssd1306_sendColor16( 0x0000, (uint32_t)w * h );
     ssd1306_intf.stop();
 }
 
@@ -290,11 +430,7 @@ void ssd1306_printChar16(uint8_t c)
     if (unicode == SSD1306_MORE_CHARS_REQUIRED) return;
     SCharInfo char_info;
     ssd1306_getCharBitmap(unicode, &char_info);
-    ssd1306_drawMonoBitmap16(ssd1306_cursorX,
-                ssd1306_cursorY,
-                char_info.width,
-                char_info.height,
-                char_info.glyph );
+    ssd1306_drawGlyph16( ssd1306_cursorX, ssd1306_cursorY, &char_info );
 }
 
 size_t ssd1306_write16(uint8_t ch)
@@ -336,11 +472,7 @@ size_t ssd1306_write16(uint8_t ch)
                     ssd1306_cursorY + s_fixedFont.h.height - 1 );
         ssd1306_color = color;
     }
-    ssd1306_drawMonoBitmap16( ssd1306_cursorX,
-                              ssd1306_cursorY,
-                              char_info.width,
-                              char_info.height,
-                              char_info.glyph);
+    ssd1306_drawGlyph16( ssd1306_cursorX, ssd1306_cursorY, &char_info );
     ssd1306_cursorX += char_info.width + char_info.spacing;
     return 1;
 }
@@ -217,6 +217,32 @@ void ssd1306_fillRect16(lcdint_t x1, lcdint_t y1, lcdint_t x2, lcdint_t y2);
  */
 void ssd1306_drawMonoBitmap16(lcdint_t xpos, lcdint_t ypos, lcduint_t w, lcduint_t h, const uint8_t *bitmap);
 
+/**
+ * Draw RLE compressed monochrome bitmap, located in Flash, directly to OLED display GDRAM.
+ * The bitmap should be in ssd1306 format, compressed as described in ssd1306_rle.h.
+ *
+ * @param xpos start horizontal position in pixels
+ * @param ypos start vertical position in pixels
+ * @param w bitmap width in pixels
+ * @param h bitmap height in pixels
+ * @param bitmap pointer to Flash data, containing compressed monochrome bitmap.
+ *
+ * @note set color with ssd1306_setColor() function.
+ */
+void ssd1306_drawRleMonoBitmap16(lcdint_t xpos, lcdint_t ypos, lcduint_t w, lcduint_t h, const uint8_t *bitmap);
+
+/**
+ * Draws char glyph, found by ssd1306_getCharBitmap(), directly to OLED display GDRAM.
+ * Plain and RLE compressed fonts are supported.
+ *
+ * @param x start horizontal position in pixels
+ * @param y start vertical position in pixels
+ * @param char_info glyph information
+ *
+ * @note set color with ssd1306_setColor() function.
+ */
+void ssd1306_drawGlyph16(lcdint_t x, lcdint_t y, const SCharInfo *char_info);
+
 /**
  * Draw 16-bit color bitmap, located in Flash, directly to OLED display GDRAM.
  * Each pixel of the bitmap is expected in 5-6-5 format.
@@ -28,6 +28,7 @@
 
 #include "ssd1306.h"
 #include "ssd1306_fonts.h"
+#include "ssd1306_rle.h"
 #include "lcd/lcd_common.h"
 #include "intf/i2c/ssd1306_i2c.h"
 #include "intf/spi/ssd1306_spi.h"
@@ -124,28 +125,33 @@ uint8_t ssd1306_printFixed(uint8_t xpos, uint8_t y, const char *ch, EFontStyle s
         x += char_info.width + char_info.spacing;
         if (char_info.height > page_offset * 8)
         {
-            char_info.glyph += page_offset * char_info.width;
+            SRleDecoder rle;
+            uint8_t compressed = s_fixedFont.h.type == SSD1306_RLE_FONT_TYPE;
+            if ( compressed )
+            {
+                ssd1306_rleInit(&rle, char_info.glyph);
+                ssd1306_rleSkip(&rle, page_offset * char_info.width);
+            }
+            else
+            {
+                char_info.glyph += page_offset * char_info.width;
+            }
             for( i = char_info.width; i>0; i--)
             {
-                uint8_t data;
-                if ( style == STYLE_NORMAL )
-                {
-                    data = pgm_read_byte(&char_info.glyph[0]);
-                }
-                else if ( style == STYLE_BOLD )
+                uint8_t data = compressed ? ssd1306_rleNext(&rle) : pgm_read_byte(char_info.glyph++);
+                if ( style == STYLE_BOLD )
                 {
-                    uint8_t temp = pgm_read_byte(&char_info.glyph[0]);
-                    data = temp | ldata;
+                    uint8_t temp = data;
+                    data |= ldata;
                     ldata = temp;
                 }
-                else
+                else if ( style != STYLE_NORMAL )
                 {
-                    uint8_t temp = pgm_read_byte(&char_info.glyph[1]);
+                    uint8_t temp = compressed ? ssd1306_rlePeek(&rle) : pgm_read_byte(char_info.glyph);
                     data = (temp & 0xF0) | ldata;
                     ldata = (temp & 0x0F);
                 }
                 ssd1306_lcd.send_pixels1(data^s_ssd1306_invertByte);
-                char_info.glyph++;
             }
         }
         else
@@ -362,23 +368,29 @@ uint8_t ssd1306_printFixedN(uint8_t xpos, uint8_t y, const char ch[], EFontStyle
         x += ((char_info.width + char_info.spacing) << factor);
         if (char_info.height > (page_offset >> factor) * 8)
         {
-            char_info.glyph += (page_offset >> factor) * char_info.width;
+            SRleDecoder rle;
+            uint8_t compressed = s_fixedFont.h.type == SSD1306_RLE_FONT_TYPE;
+            if ( compressed )
+            {
+                ssd1306_rleInit(&rle, char_info.glyph);
+                ssd1306_rleSkip(&rle, (page_offset >> factor) * char_info.width);
+            }
+            else
+            {
+                char_info.glyph += (page_offset >> factor) * char_info.width;
+            }
             for( i=char_info.width; i>0; i--)
             {
-                uint8_t data;
-                if ( style == STYLE_NORMAL )
+                uint8_t data = compressed ? ssd1306_rleNext(&rle) : pgm_read_byte(char_info.glyph++);
+                if ( style == STYLE_BOLD )
                 {
-                    data = pgm_read_byte(char_info.glyph);
-                }
-                else if ( style == STYLE_BOLD )
-                {
-                    uint8_t temp = pgm_read_byte(char_info.glyph);
-                    data = temp | ldata;
+                    uint8_t temp = data;
+                    data |= ldata;
                     ldata = temp;
                 }
-                else
+                else if ( style != STYLE_NORMAL )
                 {
-                    uint8_t temp = pgm_read_byte(char_info.glyph+1);
+                    uint8_t temp = compressed ? ssd1306_rlePeek(&rle) : pgm_read_byte(char_info.glyph);
                     data = (temp & 0xF0) | ldata;
                     ldata = (temp & 0x0F);
                 }
@@ -401,7 +413,6 @@ uint8_t ssd1306_printFixedN(uint8_t xpos, uint8_t y, const char ch[], EFontStyle
                 {
                     ssd1306_lcd.send_pixels1(data^s_ssd1306_invertByte);
                 }
-                char_info.glyph++;
             }
         }
         else
@@ -446,11 +457,7 @@ size_t ssd1306_write(uint8_t ch)
             return 0;
         }
     }
-    ssd1306_drawBitmap( ssd1306_cursorX,
-                        ssd1306_cursorY >> 3,
-                        char_info.width,
-                        char_info.height,
-                        char_info.glyph );
+    ssd1306_drawGlyph( ssd1306_cursorX, ssd1306_cursorY >> 3, &char_info );
     ssd1306_cursorX += char_info.width + char_info.spacing;
     return 1;
 }
@@ -750,9 +757,26 @@ void ssd1306_drawBuffer(uint8_t x, uint8_t y, uint8_t w, uint8_t h, const uint8_
     ssd1306_intf.stop();
 }
 
+/* Sends grayscale pixels, collected by 4-bit functions, in one transaction if possible */
+static void ssd1306_sendPixelsChunk8(const uint8_t *chunk, uint8_t len)
+{
+    if ( ssd1306_lcd.send_pixels_buffer8 )
+    {
+        if ( len ) ssd1306_lcd.send_pixels_buffer8( chunk, len );
+        return;
+    }
+    while (len--)
+    {
+        ssd1306_lcd.send_pixels8( *chunk );
+        chunk++;
+    }
+}
+
 void ssd1306_drawBuffer1_4(uint8_t x, uint8_t y, uint8_t w, uint8_t h, const uint8_t *buf)
 {
+    uint8_t chunk[32];
     uint8_t i, j, k;
+    uint8_t n = 0;
     ssd1306_lcd.set_block(x, y>>3, w);
     uint8_t y_offset = (y & 0x07);
     uint8_t x_offset = (x & 0x01);
@@ -762,22 +786,26 @@ void ssd1306_drawBuffer1_4(uint8_t x, uint8_t y, uint8_t w, uint8_t h, const uin
         {
             for( k = 0; k < 8; k++)
             {
+                uint8_t data = 0x00;
                 if ((j*8 + k - y_offset < h) && (k >= y_offset || j != 0))
                 {
-                    uint8_t data = (i < w / 2) ? buf[ i + (j * 8 + k - y_offset) * w / 2 ]: 0x00;
+                    data = (i < w / 2) ? buf[ i + (j * 8 + k - y_offset) * w / 2 ]: 0x00;
                     if ( x_offset )
                     {
                         data <<= 4;
                         if ( i > 0) data |= buf[ i + (j * 8 + k - y_offset) * w / 2 - 1] >> 4;
                     }
-                    ssd1306_lcd.send_pixels8( data );
-                }
-                else
-                {
-                    ssd1306_lcd.send_pixels8( 0x00 );
                 }
+                chunk[n++] = data;
+            }
+            if ( n == sizeof(chunk) )
+            {
+                ssd1306_sendPixelsChunk8( chunk, n );
+                n = 0;
             }
         }
+        ssd1306_sendPixelsChunk8( chunk, n );
+        n = 0;
         ssd1306_lcd.next_page();
     }
     ssd1306_intf.stop();
@@ -801,9 +829,54 @@ void ssd1306_drawBitmap(uint8_t x, uint8_t y, uint8_t w, uint8_t h, const uint8_
     ssd1306_intf.stop();
 }
 
+void ssd1306_drawRleBitmap(uint8_t x, uint8_t y, uint8_t w, uint8_t h, const uint8_t *buf)
+{
+    uint8_t chunk[16];
+    SRleDecoder rle;
+    uint8_t remainder = (ssd1306_lcd.width - x) < w ? (w + x - ssd1306_lcd.width): 0;
+    w -= remainder;
+    ssd1306_rleInit(&rle, buf);
+    ssd1306_lcd.set_block(x, y, w);
+    for(uint8_t j=(h >> 3); j>0; j--)
+    {
+        uint8_t i = w;
+        while (i)
+        {
+            uint8_t n = i < sizeof(chunk) ? i : sizeof(chunk);
+            ssd1306_rleRead(&rle, chunk, n);
+            if (s_ssd1306_invertByte)
+            {
+                for (uint8_t k = 0; k < n; k++)
+                {
+                    chunk[k] ^= s_ssd1306_invertByte;
+                }
+            }
+            ssd1306_lcd.send_pixels_buffer1(chunk, n);
+            i -= n;
+        }
+        ssd1306_rleSkip(&rle, remainder);
+        ssd1306_lcd.next_page();
+    }
+    ssd1306_intf.stop();
+}
+
+void ssd1306_drawGlyph(uint8_t x, uint8_t y, const SCharInfo *char_info)
+{
+    if ( s_fixedFont.h.type == SSD1306_RLE_FONT_TYPE )
+    {
+        ssd1306_drawRleBitmap(x, y, char_info->width, char_info->height, char_info->glyph);
+    }
+    else
+    {
+        ssd1306_drawBitmap(x, y, char_info->width, char_info->height, char_info->glyph);
+    }
+}
+
 void ssd1306_drawBitmap1_4(uint8_t x, uint8_t y, uint8_t w, uint8_t h, const uint8_t *buf)
 {
+    uint8_t chunk[32];
     uint8_t i, j, k;
+    uint8_t n = 0;
     ssd1306_lcd.set_block(x, y>>3, w);
     uint8_t y_offset = (y & 0x07);
     uint8_t x_offset = (x & 0x01);
@@ -813,22 +886,26 @@ void ssd1306_drawBitmap1_4(uint8_t x, uint8_t y, uint8_t w, uint8_t h, const uin
         {
             for( k = 0; k < 8; k++)
             {
+                uint8_t data = 0x00;
                 if ((j*8 + k - y_offset < h) && (k >= y_offset || j != 0))
                 {
-                    uint8_t data = (i < w / 2) ? pgm_read_byte( &buf[ i + (j * 8 + k - y_offset) * w / 2 ] ) : 0x00;
+                    data = (i < w / 2) ? pgm_read_byte( &buf[ i + (j * 8 + k - y_offset) * w / 2 ] ) : 0x00;
                     if ( x_offset )
                     {
                         data <<= 4;
                         if ( i > 0) data |= pgm_read_byte( &buf[ i + (j * 8 + k - y_offset) * w / 2 - 1] ) >> 4;
                     }
-                    ssd1306_lcd.send_pixels8( data );
-                }
-                else
-                {
-                    ssd1306_lcd.send_pixels8( 0x00 );
                 }
+                chunk[n++] = data;
+            }
+            if ( n == sizeof(chunk) )
+            {
+                ssd1306_sendPixelsChunk8( chunk, n );
+                n = 0;
             }
         }
+        ssd1306_sendPixelsChunk8( chunk, n );
+        n = 0;
         ssd1306_lcd.next_page();
     }
     ssd1306_intf.stop();
@@ -1096,3 +1173,164 @@ void ssd1306_setFont6x8(const uint8_t * progmemFont)
     s_font6x8 = progmemFont + 4;
 }
 
+
+#ifdef CONFIG_SSD1306_SHADOW_BUFFER_ENABLE
+
+#define SHADOW_WIDTH   128
+#define SHADOW_PAGES   (64 >> 3)
+
+static uint8_t s_shadow[SHADOW_PAGES][SHADOW_WIDTH];
+/* Dirty column range for each page. Page is clean if start > end */
+static uint8_t s_dirtyStart[SHADOW_PAGES];
+static uint8_t s_dirtyEnd[SHADOW_PAGES];
+static uint8_t s_shadowEnabled = 0;
+/* Original display driver, used to upload shadow buffer content */
+static ssd1306_lcd_t s_shadowLcd;
+static void (*s_shadowStart)(void);
+static void (*s_shadowStop)(void);
+/* Set, when real transaction is started on the bus */
+static uint8_t s_shadowBusActive = 0;
+/* Current block and write position in the shadow buffer */
+static lcduint_t s_shadowX0;
+static lcduint_t s_shadowX1;
+static lcduint_t s_shadowX;
+static lcduint_t s_shadowPage;
+
+static void shadow_start(void)
+{
+    s_shadowBusActive = 1;
+    s_shadowStart();
+}
+
+static void shadow_stop(void)
+{
+    /* Drawing functions call stop() after each block, but nothing is sent until ssd1306_flush() */
+    if (s_shadowBusActive)
+    {
+        s_shadowBusActive = 0;
+        s_shadowStop();
+    }
+}
+
+static void shadow_set_block(lcduint_t x, lcduint_t y, lcduint_t w)
+{
+    lcduint_t rx = w ? (x + w - 1) : (ssd1306_lcd.width - 1);
+    s_shadowX0 = x;
+    s_shadowX1 = rx < ssd1306_lcd.width ? rx : (ssd1306_lcd.width - 1);
+    s_shadowX = x;
+    s_shadowPage = y;
+}
+
+static void shadow_next_page(void)
+{
+    s_shadowX = s_shadowX0;
+    s_shadowPage++;
+}
+
+static void shadow_send_pixels1(uint8_t data)
+{
+    lcduint_t x = s_shadowX++;
+    if ( (x > s_shadowX1) || (s_shadowPage >= (ssd1306_lcd.height >> 3)) )
+    {
+        return;
+    }
+    if (s_shadow[s_shadowPage][x] != data)
+    {
+        s_shadow[s_shadowPage][x] = data;
+        if (x < s_dirtyStart[s_shadowPage]) s_dirtyStart[s_shadowPage] = x;
+        if (x > s_dirtyEnd[s_shadowPage]) s_dirtyEnd[s_shadowPage] = x;
+    }
+}
+
+static void shadow_send_pixels_buffer1(const uint8_t *buffer, uint16_t len)
+{
+    while (len--)
+    {
+        shadow_send_pixels1(*buffer);
+        buffer++;
+    }
+}
+
+static void shadow_mark_clean(void)
+{
+    for (uint8_t page = 0; page < SHADOW_PAGES; page++)
+    {
+        s_dirtyStart[page] = 0xFF;
+        s_dirtyEnd[page] = 0;
+    }
+}
+
+void ssd1306_enableShadowBuffer(void)
+{
+    if ( s_shadowEnabled || (ssd1306_lcd.width > SHADOW_WIDTH) ||
+         ((ssd1306_lcd.height >> 3) > SHADOW_PAGES) )
+    {
+        return;
+    }
+    s_shadowLcd = ssd1306_lcd;
+    s_shadowStart = ssd1306_intf.start;
+    s_shadowStop = ssd1306_intf.stop;
+    s_shadowBusActive = 0;
+    ssd1306_intf.start = shadow_start;
+    ssd1306_intf.stop = shadow_stop;
+    ssd1306_lcd.set_block = shadow_set_block;
+    ssd1306_lcd.next_page = shadow_next_page;
+    ssd1306_lcd.send_pixels1 = shadow_send_pixels1;
+    ssd1306_lcd.send_pixels_buffer1 = shadow_send_pixels_buffer1;
+    /* GDRAM content is unknown, so the first flush uploads the whole screen */
+    memset(s_shadow, 0, sizeof(s_shadow));
+    for (uint8_t page = 0; page < SHADOW_PAGES; page++)
+    {
+        s_dirtyStart[page] = 0;
+        s_dirtyEnd[page] = ssd1306_lcd.width - 1;
+    }
+    s_shadowEnabled = 1;
+}
+
+void ssd1306_flush(void)
+{
+    if (!s_shadowEnabled)
+    {
+        return;
+    }
+    for (uint8_t page = 0; page < (ssd1306_lcd.height >> 3); page++)
+    {
+        if (s_dirtyStart[page] > s_dirtyEnd[page])
+        {
+            continue;
+        }
+        uint8_t len = s_dirtyEnd[page] - s_dirtyStart[page] + 1;
+        s_shadowLcd.set_block(s_dirtyStart[page], page, len);
+        if (s_shadowLcd.send_pixels_buffer1)
+        {
+            s_shadowLcd.send_pixels_buffer1(&s_shadow[page][s_dirtyStart[page]], len);
+        }
+        else
+        {
+            for (uint8_t i = 0; i < len; i++)
+            {
+                s_shadowLcd.send_pixels1(s_shadow[page][s_dirtyStart[page] + i]);
+            }
+        }
+        ssd1306_intf.stop();
+    }
+    shadow_mark_clean();
+}
+
+void ssd1306_disableShadowBuffer(void)
+{
+    if (!s_shadowEnabled)
+    {
+        return;
+    }
+    ssd1306_flush();
+    s_shadowEnabled = 0;
+    ssd1306_lcd.set_block = s_shadowLcd.set_block;
+    ssd1306_lcd.next_page = s_shadowLcd.next_page;
+    ssd1306_lcd.send_pixels1 = s_shadowLcd.send_pixels1;
+    ssd1306_lcd.send_pixels_buffer1 = s_shadowLcd.send_pixels_buffer1;
+    ssd1306_intf.start = s_shadowStart;
+    ssd1306_intf.stop = s_shadowStop;
+}
+
+#endif
@@ -352,6 +352,29 @@ void         ssd1306_drawBufferFast(lcdint_t x, lcdint_t y, lcduint_t w, lcduint
  */
 void         ssd1306_drawBitmap(uint8_t x, uint8_t y, uint8_t w, uint8_t h, const uint8_t *buf);
 
+/**
+ * Draws RLE compressed bitmap, located in Flash, on the display
+ * The bitmap should be in native ssd1306 format, compressed as described in ssd1306_rle.h.
+ * The bitmap is decoded while sending to the display, no RAM buffer for whole image is required.
+ *
+ * @param x - horizontal position in pixels
+ * @param y - vertical position in blocks (pixels/8)
+ * @param w - width of bitmap in pixels
+ * @param h - height of bitmap in pixels (must be divided by 8)
+ * @param buf - pointer to compressed data, located in Flash
+ */
+void         ssd1306_drawRleBitmap(uint8_t x, uint8_t y, uint8_t w, uint8_t h, const uint8_t *buf);
+
+/**
+ * Draws char glyph, found by ssd1306_getCharBitmap(), on the display.
+ * Plain and RLE compressed fonts are supported.
+ *
+ * @param x - horizontal position in pixels
+ * @param y - vertical position in blocks (pixels/8)
+ * @param char_info - glyph information
+ */
+void         ssd1306_drawGlyph(uint8_t x, uint8_t y, const SCharInfo *char_info);
+
 /**
  * Draws bitmap, located in Flash, on the display
  * The bitmap should be in XBMP format
@@ -447,6 +470,40 @@ SPRITE       ssd1306_createSprite(uint8_t x, uint8_t y, uint8_t w, const uint8_t
  */
 void         ssd1306_replaceSprite(SPRITE *sprite, const uint8_t *data);
 
+#ifdef CONFIG_SSD1306_SHADOW_BUFFER_ENABLE
+
+/**
+ * @brief Enables retained mode for direct draw functions.
+ *
+ * Switches direct draw functions to 1 KiB shadow buffer: all 1-bit functions
+ * (ssd1306_putPixel(), ssd1306_drawLine(), ssd1306_printFixed(), etc.) write to RAM
+ * instead of the display, and the library tracks changed column range for each page.
+ * Call ssd1306_flush() to send changed areas to the display. The shadow buffer
+ * supports displays up to 128x64 pixels in ssd1306 compatible mode. Call this function
+ * after display and communication interface initialization. The first ssd1306_flush()
+ * sends the whole screen.
+ *
+ * @note CONFIG_SSD1306_SHADOW_BUFFER_ENABLE must be defined in UserSettings.h
+ * @see ssd1306_flush()
+ * @see ssd1306_disableShadowBuffer()
+ */
+void         ssd1306_enableShadowBuffer(void);
+
+/**
+ * @brief Sends changed areas of the shadow buffer to the display.
+ *
+ * Sends only dirty column range of each changed page, so the whole update
+ * takes at most one transaction per page.
+ */
+void         ssd1306_flush(void);
+
+/**
+ * @brief Flushes shadow buffer and switches back to direct draw mode.
+ */
+void         ssd1306_disableShadowBuffer(void);
+
+#endif
+
 /**
  * @}
  */
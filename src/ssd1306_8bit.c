@@ -24,6 +24,7 @@
 
 #include "ssd1306_8bit.h"
 #include "ssd1306_generic.h"
+#include "ssd1306_rle.h"
 //#include "ssd1306_fonts.h"
 #include "intf/ssd1306_interface.h"
 #include "intf/spi/ssd1306_spi.h"
@@ -87,9 +88,39 @@ void ssd1306_drawMonoBuffer8(lcdint_t xpos, lcdint_t ypos, lcduint_t w, lcduint_
     ssd1306_intf.stop();
 }
 
+static void ssd1306_sendColor8(uint8_t color, uint32_t count)
+{
+    if ( ssd1306_lcd.send_pixels_buffer8 )
+    {
+        uint8_t chunk[16];
+        memset( chunk, color, sizeof(chunk) );
+        while (count)
+        {
+            uint8_t len = count < sizeof(chunk) ? count : sizeof(chunk);
+            ssd1306_lcd.send_pixels_buffer8( chunk, len );
+            count -= len;
+        }
+        return;
+    }
+    while (count--)
+    {
+        ssd1306_lcd.send_pixels8( color );
+    }
+}
+
 static void ssd1306_drawBufferPitch8(lcdint_t x, lcdint_t y, lcduint_t w, lcduint_t h, lcduint_t pitch, const uint8_t *data)
 {
     ssd1306_lcd.set_block(x, y, w);
+    if ( ssd1306_lcd.send_pixels_buffer8 )
+    {
+        while (h--)
+        {
+            ssd1306_lcd.send_pixels_buffer8( data, w );
+            data += pitch;
+        }
+        ssd1306_intf.stop();
+        return;
+    }
     while (h--)
     {
         lcduint_t line = w;
@@ -108,6 +139,11 @@ void ssd1306_drawBufferFast8(lcdint_t x, lcdint_t y, lcduint_t w, lcduint_t h, c
     ssd1306_drawBufferPitch8( x, y, w, h, w, data );
 }
 
+void ssd1306_drawBufferFast4(lcdint_t x, lcdint_t y, lcduint_t w, lcduint_t h, const uint8_t *data)
+{
+    ssd1306_drawBufferPitch8( x >> 1, y, w >> 1, h, w >> 1, data );
+}
+
 void ssd1306_drawBufferEx8(lcdint_t x, lcdint_t y, lcduint_t w, lcduint_t h, lcduint_t pitch, const uint8_t *data)
 {
     ssd1306_drawBufferPitch8( x, y, w, h, pitch, data );
@@ -115,12 +151,13 @@ void ssd1306_drawBufferEx8(lcdint_t x, lcdint_t y, lcduint_t w, lcduint_t h, lcd
 
 void ssd1306_fillScreen8(uint8_t fill_Data)
 {
-    ssd1306_lcd.set_block(0, 0, 0);
-    uint32_t count = (uint32_t)ssd1306_lcd.width * (uint32_t)ssd1306_lcd.height;
-    while (count--)
+    if ( ssd1306_lcd.fill_rect &&
+         ssd1306_lcd.fill_rect(0, 0, ssd1306_lcd.width - 1, ssd1306_lcd.height - 1, RGB8_TO_RGB16(fill_Data)) )
     {
-        ssd1306_lcd.send_pixels8( fill_Data );
+        return;
     }
+    ssd1306_lcd.set_block(0, 0, 0);
+    ssd1306_sendColor8( fill_Data, (uint32_t)ssd1306_lcd.width * (uint32_t)ssd1306_lcd.height );
     ssd1306_intf.stop();
 }
 
@@ -167,6 +204,10 @@ void ssd1306_drawHLine8(lcdint_t x1, lcdint_t y1, lcdint_t x2)
 
 void ssd1306_drawLine8(lcdint_t x1, lcdint_t y1, lcdint_t x2, lcdint_t y2)
 {
+    if ( ssd1306_lcd.draw_line && ssd1306_lcd.draw_line(x1, y1, x2, y2, RGB8_TO_RGB16(ssd1306_color)) )
+    {
+        return;
+    }
     lcduint_t  dx = x1 > x2 ? (x1 - x2): (x2 - x1);
     lcduint_t  dy = y1 > y2 ? (y1 - y2): (y2 - y1);
     lcduint_t  err = 0;
@@ -226,12 +267,12 @@ void ssd1306_fillRect8(lcdint_t x1, lcdint_t y1, lcdint_t x2, lcdint_t y2)
     {
         ssd1306_swap_data(x1, x2, lcdint_t);
     }
-    ssd1306_lcd.set_block(x1, y1, x2 - x1 + 1);
-    uint16_t count = (x2 - x1 + 1) * (y2 - y1 + 1);
-    while (count--)
+    if ( ssd1306_lcd.fill_rect && ssd1306_lcd.fill_rect(x1, y1, x2, y2, RGB8_TO_RGB16(ssd1306_color)) )
     {
-        ssd1306_lcd.send_pixels8( ssd1306_color );
+        return;
     }
+    ssd1306_lcd.set_block(x1, y1, x2 - x1 + 1);
+    ssd1306_sendColor8( ssd1306_color, (uint16_t)((x2 - x1 + 1) * (y2 - y1 + 1)) );
     ssd1306_intf.stop();
 }
 
@@ -266,6 +307,54 @@ void ssd1306_drawMonoBitmap8(lcdint_t xpos, lcdint_t ypos, lcduint_t w, lcduint_
     ssd1306_intf.stop();
 }
 
+void ssd1306_drawRleMonoBitmap8(lcdint_t xpos, lcdint_t ypos, lcduint_t w, lcduint_t h, const uint8_t *bitmap)
+{
+    /* Bitmap is decoded by vertical strips, so glyphs up to 32 pixels wide are sent as single block */
+    uint8_t chunk[32];
+    SRleDecoder rle;
+    uint8_t blackColor = s_ssd1306_invertByte ? ssd1306_color : 0x00;
+    uint8_t color = s_ssd1306_invertByte ? 0x00 : ssd1306_color;
+    ssd1306_rleInit(&rle, bitmap);
+    while (h)
+    {
+        uint8_t rows = h < 8 ? h : 8;
+        lcduint_t x = 0;
+        while (x < w)
+        {
+            uint8_t n = (w - x) < sizeof(chunk) ? (w - x) : sizeof(chunk);
+            ssd1306_rleRead(&rle, chunk, n);
+            ssd1306_lcd.set_block(xpos + x, ypos, n);
+            for (uint8_t row = 0; row < rows; row++)
+            {
+                uint8_t bit = 1 << row;
+                for (uint8_t i = 0; i < n; i++)
+                {
+                    if ( chunk[i] & bit )
+                        ssd1306_lcd.send_pixels8( color );
+                    else
+                        ssd1306_lcd.send_pixels8( blackColor );
+                }
+            }
+            ssd1306_intf.stop();
+            x += n;
+        }
+        ypos += rows;
+        h -= rows;
+    }
+}
+
+void ssd1306_drawGlyph8(lcdint_t x, lcdint_t y, const SCharInfo *char_info)
+{
+    if ( s_fixedFont.h.type == SSD1306_RLE_FONT_TYPE )
+    {
+        ssd1306_drawRleMonoBitmap8(x, y, char_info->width, char_info->height, char_info->glyph);
+    }
+    else
+    {
+        ssd1306_drawMonoBitmap8(x, y, char_info->width, char_info->height, char_info->glyph);
+    }
+}
+
 void ssd1306_drawBitmap8(lcdint_t xpos, lcdint_t ypos, lcduint_t w, lcduint_t h, const uint8_t *bitmap)
 {
     ssd1306_lcd.set_block(xpos, ypos, w);
@@ -280,12 +369,13 @@ void ssd1306_drawBitmap8(lcdint_t xpos, lcdint_t ypos, lcduint_t w, lcduint_t h,
 
 void ssd1306_clearBlock8(uint8_t x, uint8_t y, uint8_t w, uint8_t h)
 {
-    ssd1306_lcd.set_block(x, y, w);
-    uint32_t count = w * h;
-    while (count--)
+    if ( w && h && ssd1306_lcd.fill_rect &&
+         ssd1306_lcd.fill_rect(x, y, x + w - 1, y + h - 1, 0) )
     {
-        ssd1306_lcd.send_pixels8( 0x00 );
+        return;
     }
+    ssd1306_lcd.set_block(x, y, w);
+    ssd1306_sendColor8( 0x00, (uint32_t)w * h );
     ssd1306_intf.stop();
 }
 
@@ -301,11 +391,7 @@ void ssd1306_printChar8(uint8_t c)
     if (unicode == SSD1306_MORE_CHARS_REQUIRED) return;
     SCharInfo char_info;
     ssd1306_getCharBitmap(unicode, &char_info);
-    ssd1306_drawMonoBitmap8(ssd1306_cursorX,
-                ssd1306_cursorY,
-                char_info.width,
-                char_info.height,
-                char_info.glyph );
+    ssd1306_drawGlyph8( ssd1306_cursorX, ssd1306_cursorY, &char_info );
 }
 
 size_t ssd1306_write8(uint8_t ch)
@@ -348,11 +434,7 @@ size_t ssd1306_write8(uint8_t ch)
                     ssd1306_cursorY + s_fixedFont.h.height - 1 );
         ssd1306_color = color;
     }
-    ssd1306_drawMonoBitmap8( ssd1306_cursorX,
-                             ssd1306_cursorY,
-                             char_info.width,
-                             char_info.height,
-                             char_info.glyph);
+    ssd1306_drawGlyph8( ssd1306_cursorX, ssd1306_cursorY, &char_info );
     ssd1306_cursorX += char_info.width + char_info.spacing;
     return 1;
 }
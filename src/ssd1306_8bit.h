@@ -109,6 +109,20 @@ void ssd1306_drawMonoBuffer8(lcdint_t xpos, lcdint_t ypos, lcduint_t w, lcduint_
  */
 void ssd1306_drawBufferFast8(lcdint_t x, lcdint_t y, lcduint_t w, lcduint_t h, const uint8_t *data);
 
+/**
+ * Draws 4-bit grayscale bitmap, located in SRAM, on ssd1325/ssd1327 display in normal mode.
+ * Each byte represents 2 horizontal pixels, left pixel in low nibble (NanoCanvas4 format).
+ * Grayscale controllers address columns by pairs of pixels, so the whole bitmap is
+ * sent to the display without any conversion.
+ *
+ * @param x - horizontal position in pixels (must be even)
+ * @param y - vertical position in pixels
+ * @param w - width of bitmap in pixels (must be even)
+ * @param h - height of bitmap in pixels
+ * @param data - pointer to data, located in SRAM.
+ */
+void ssd1306_drawBufferFast4(lcdint_t x, lcdint_t y, lcduint_t w, lcduint_t h, const uint8_t *data);
+
 /**
  * Draws 8-bit bitmap, located in SRAM, on the display, taking into account pitch parameter.
  * Each byte represents separate pixel: refer to RGB_COLOR8 to understand RGB scheme, being used.
@@ -232,6 +246,32 @@ void ssd1306_fillRect8(lcdint_t x1, lcdint_t y1, lcdint_t x2, lcdint_t y2);
  */
 void ssd1306_drawMonoBitmap8(lcdint_t xpos, lcdint_t ypos, lcduint_t w, lcduint_t h, const uint8_t *bitmap);
 
+/**
+ * Draw RLE compressed monochrome bitmap, located in Flash, directly to OLED display GDRAM.
+ * The bitmap should be in ssd1306 format, compressed as described in ssd1306_rle.h.
+ *
+ * @param xpos start horizontal position in pixels
+ * @param ypos start vertical position in pixels
+ * @param w bitmap width in pixels
+ * @param h bitmap height in pixels
+ * @param bitmap pointer to Flash data, containing compressed monochrome bitmap.
+ *
+ * @note set color with ssd1306_setColor() function.
+ */
+void ssd1306_drawRleMonoBitmap8(lcdint_t xpos, lcdint_t ypos, lcduint_t w, lcduint_t h, const uint8_t *bitmap);
+
+/**
+ * Draws char glyph, found by ssd1306_getCharBitmap(), directly to OLED display GDRAM.
+ * Plain and RLE compressed fonts are supported.
+ *
+ * @param x start horizontal position in pixels
+ * @param y start vertical position in pixels
+ * @param char_info glyph information
+ *
+ * @note set color with ssd1306_setColor() function.
+ */
+void ssd1306_drawGlyph8(lcdint_t x, lcdint_t y, const SCharInfo *char_info);
+
 /**
  * Draw 8-bit color bitmap, located in Flash, directly to OLED display GDRAM.
  * Each pixel of the bitmap is expected in 3-3-2 format.
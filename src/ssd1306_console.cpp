@@ -69,11 +69,7 @@ size_t ssd1306_consoleWriter(uint8_t ch)
     if (unicode == SSD1306_MORE_CHARS_REQUIRED) return 0;
     SCharInfo char_info;
     ssd1306_getCharBitmap(unicode, &char_info);
-    ssd1306_drawBitmap( ssd1306_cursorX,
-                        ssd1306_cursorY >> 3,
-                        char_info.width,
-                        char_info.height,
-                        char_info.glyph );
+    ssd1306_drawGlyph( ssd1306_cursorX, ssd1306_cursorY >> 3, &char_info );
     ssd1306_cursorX += char_info.width + char_info.spacing;
     return 1;
 }
@@ -0,0 +1,230 @@
+/*
+    MIT License
+
+    Copyright (c) 2019, Alexey Dynda
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include "ssd1306_convert.h"
+#include "nano_gfx_types.h"
+#include "lcd/lcd_common.h"
+#include "intf/ssd1306_interface.h"
+
+/* 4x4 ordered dither matrix, values 0-15 */
+static const PROGMEM uint8_t s_bayer4x4[4][4] =
+{
+    {  0,  8,  2, 10 },
+    { 12,  4, 14,  6 },
+    {  3, 11,  1,  9 },
+    { 15,  7, 13,  5 },
+};
+
+static void ssd1306_ditherRow(uint8_t *row, lcduint_t x, lcduint_t y)
+{
+    // Rotate the row, so that row[0] corresponds to the first pixel
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        row[i] = pgm_read_byte( &s_bayer4x4[y & 3][(x + i) & 3] );
+    }
+}
+
+static inline uint8_t ssd1306_gray8(uint8_t r, uint8_t g, uint8_t b)
+{
+    return ((uint16_t)r * 77 + (uint16_t)g * 150 + (uint16_t)b * 29) >> 8;
+}
+
+static inline uint8_t ssd1306_gray8FromRgb8(uint8_t c)
+{
+    uint8_t r = c >> 5;
+    uint8_t g = (c >> 2) & 0x07;
+    uint8_t b = c & 0x03;
+    return ssd1306_gray8( (r << 5) | (r << 2) | (r >> 1),
+                          (g << 5) | (g << 2) | (g >> 1),
+                          b * 85 );
+}
+
+static inline uint8_t ssd1306_gray8FromRgb16(const uint8_t *p)
+{
+    uint8_t r = p[0] >> 3;
+    uint8_t g = ((p[0] & 0x07) << 3) | (p[1] >> 5);
+    uint8_t b = p[1] & 0x1F;
+    return ssd1306_gray8( (r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2) );
+}
+
+void ssd1306_convertRgb8ToRgb16(uint8_t *dst, const uint8_t *src, lcduint_t count)
+{
+    while (count--)
+    {
+        uint8_t c = *src++;
+        // RGB8_TO_RGB16() split to high and low bytes
+        *dst++ = (c & 0xE0) | ((c & 0x1C) >> 2);
+        *dst++ = (c & 0x03) << 3;
+    }
+}
+
+static void ssd1306_rgb16ToRgb8(uint8_t *dst, const uint8_t *src, lcduint_t count, const uint8_t *dither)
+{
+    for (lcduint_t i = 0; i < count; i++, src += 2)
+    {
+        uint8_t d = dither ? dither[i & 3] : 0;
+        uint8_t r = (src[0] >> 3) + (d >> 2);
+        uint8_t g = (((src[0] & 0x07) << 3) | (src[1] >> 5)) + (d >> 1);
+        uint8_t b = (src[1] & 0x1F) + (d >> 1);
+        if (r > 0x1F) r = 0x1F;
+        if (g > 0x3F) g = 0x3F;
+        if (b > 0x1F) b = 0x1F;
+        dst[i] = ((r >> 2) << 5) | ((g >> 3) << 2) | (b >> 3);
+    }
+}
+
+void ssd1306_convertRgb16ToRgb8(uint8_t *dst, const uint8_t *src, lcduint_t count)
+{
+    ssd1306_rgb16ToRgb8( dst, src, count, NULL );
+}
+
+void ssd1306_convertRgb16ToRgb8Dither(uint8_t *dst, const uint8_t *src, lcduint_t count,
+                                      lcduint_t x, lcduint_t y)
+{
+    uint8_t dither[4];
+    ssd1306_ditherRow( dither, x, y );
+    ssd1306_rgb16ToRgb8( dst, src, count, dither );
+}
+
+static void ssd1306_rgb8ToGray4(uint8_t *dst, const uint8_t *src, lcduint_t count)
+{
+    for (lcduint_t i = 0; i < count; i++)
+    {
+        uint8_t c = src[i];
+        uint8_t gray = RGB8_TO_GRAY4( c );
+        if ( i & 1 )
+        {
+            dst[i >> 1] |= gray << 4;
+        }
+        else
+        {
+            dst[i >> 1] = gray;
+        }
+    }
+}
+
+static void ssd1306_rgb16ToGray4(uint8_t *dst, const uint8_t *src, lcduint_t count, const uint8_t *dither)
+{
+    uint8_t chunk[16];
+    while (count)
+    {
+        // chunk size is multiple of 4, so dither pattern and pixel pairs are kept
+        lcduint_t n = count < sizeof(chunk) ? count : sizeof(chunk);
+        ssd1306_rgb16ToRgb8( chunk, src, n, dither );
+        ssd1306_rgb8ToGray4( dst, chunk, n );
+        dst += n >> 1;
+        src += n << 1;
+        count -= n;
+    }
+}
+
+void ssd1306_convertRgb8ToGray4(uint8_t *dst, const uint8_t *src, lcduint_t count)
+{
+    ssd1306_rgb8ToGray4( dst, src, count );
+}
+
+void ssd1306_convertRgb16ToGray4(uint8_t *dst, const uint8_t *src, lcduint_t count)
+{
+    ssd1306_rgb16ToGray4( dst, src, count, NULL );
+}
+
+void ssd1306_convertRgb16ToGray4Dither(uint8_t *dst, const uint8_t *src, lcduint_t count,
+                                       lcduint_t x, lcduint_t y)
+{
+    uint8_t dither[4];
+    ssd1306_ditherRow( dither, x, y );
+    ssd1306_rgb16ToGray4( dst, src, count, dither );
+}
+
+static void ssd1306_toMono(uint8_t *dst, const uint8_t *src, lcduint_t count,
+                           uint8_t bpp, uint8_t bit, const uint8_t *dither)
+{
+    uint8_t mask = 1 << bit;
+    for (lcduint_t i = 0; i < count; i++)
+    {
+        uint8_t gray = bpp == 8 ? ssd1306_gray8FromRgb8( src[i] ) : ssd1306_gray8FromRgb16( &src[i << 1] );
+        uint8_t threshold = dither ? (dither[i & 3] << 4) + 8 : 128;
+        if ( gray >= threshold )
+        {
+            dst[i] |= mask;
+        }
+        else
+        {
+            dst[i] &= ~mask;
+        }
+    }
+}
+
+void ssd1306_convertRgb8ToMono(uint8_t *dst, const uint8_t *src, lcduint_t count, uint8_t bit)
+{
+    ssd1306_toMono( dst, src, count, 8, bit, NULL );
+}
+
+void ssd1306_convertRgb8ToMonoDither(uint8_t *dst, const uint8_t *src, lcduint_t count,
+                                     lcduint_t x, lcduint_t y)
+{
+    uint8_t dither[4];
+    ssd1306_ditherRow( dither, x, y );
+    ssd1306_toMono( dst, src, count, 8, y & 0x07, dither );
+}
+
+void ssd1306_convertRgb16ToMono(uint8_t *dst, const uint8_t *src, lcduint_t count, uint8_t bit)
+{
+    ssd1306_toMono( dst, src, count, 16, bit, NULL );
+}
+
+void ssd1306_convertRgb16ToMonoDither(uint8_t *dst, const uint8_t *src, lcduint_t count,
+                                      lcduint_t x, lcduint_t y)
+{
+    uint8_t dither[4];
+    ssd1306_ditherRow( dither, x, y );
+    ssd1306_toMono( dst, src, count, 16, y & 0x07, dither );
+}
+
+void ssd1306_drawBuffer16ToMono(lcdint_t x, lcdint_t y, lcduint_t w, lcduint_t h, const uint8_t *buf)
+{
+    ssd1306_drawBufferEx16ToMono(x, y, w, h, w << 1, buf);
+}
+
+void ssd1306_drawBufferEx16ToMono(lcdint_t x, lcdint_t y, lcduint_t w, lcduint_t h,
+                                  lcduint_t pitch, const uint8_t *buf)
+{
+    uint8_t chunk[32];
+    ssd1306_lcd.set_block(x, y >> 3, w);
+    for (lcduint_t page = 0; page < (h >> 3); page++)
+    {
+        for (lcduint_t col = 0; col < w; col += sizeof(chunk))
+        {
+            lcduint_t n = (w - col) < sizeof(chunk) ? (w - col) : sizeof(chunk);
+            for (uint8_t row = 0; row < 8; row++)
+            {
+                const uint8_t *src = buf + (uint32_t)((page << 3) + row) * pitch + (col << 1);
+                ssd1306_convertRgb16ToMonoDither( chunk, src, n, x + col, y + (page << 3) + row );
+            }
+            ssd1306_lcd.send_pixels_buffer1( chunk, n );
+        }
+        ssd1306_lcd.next_page();
+    }
+    ssd1306_intf.stop();
+}
@@ -0,0 +1,180 @@
+/*
+    MIT License
+
+    Copyright (c) 2019, Alexey Dynda
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+/**
+ * @file ssd1306_convert.h Pixel format conversion functions
+ */
+
+#ifndef _SSD1306_CONVERT_H_
+#define _SSD1306_CONVERT_H_
+
+#include "ssd1306_hal/io.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup LCD_CONVERT_API CONVERT: Pixel format conversion
+ * @{
+ *
+ * @brief Functions to convert rows of pixels between formats, supported by the library
+ *
+ * @details Functions convert count pixels from src buffer to dst buffer, both located in SRAM.
+ *          Supported formats are:
+ *          - RGB8: 1 byte per pixel, 3-3-2 format
+ *          - RGB16: 2 bytes per pixel, 5-6-5 format, high byte first (as in NanoCanvas16 buffer)
+ *          - GRAY4: 2 pixels per byte, first pixel in low nibble (as in NanoCanvas1_4 buffer).
+ *            Gray level is calculated the same way as RGB8_TO_GRAY4() does.
+ *          - MONO: 1 bit per pixel in ssd1306 format. Row of pixels is written to specified bit
+ *            of count bytes, so 8 rows converted to bits 0-7 of the same buffer make one page.
+ *
+ *          Functions with Dither suffix apply 4x4 ordered dithering. x and y specify position
+ *          of the first pixel on the screen, so adjacent rows and blocks keep dither pattern.
+ */
+
+/**
+ * Converts RGB8 pixels to RGB16 format.
+ * @param dst destination buffer of count * 2 bytes
+ * @param src source buffer of count bytes
+ * @param count number of pixels to convert
+ */
+void ssd1306_convertRgb8ToRgb16(uint8_t *dst, const uint8_t *src, lcduint_t count);
+
+/**
+ * Converts RGB16 pixels to RGB8 format.
+ * @param dst destination buffer of count bytes
+ * @param src source buffer of count * 2 bytes
+ * @param count number of pixels to convert
+ */
+void ssd1306_convertRgb16ToRgb8(uint8_t *dst, const uint8_t *src, lcduint_t count);
+
+/**
+ * @copydoc ssd1306_convertRgb16ToRgb8
+ * @param x horizontal position of the first pixel on the screen
+ * @param y vertical position of the row on the screen
+ */
+void ssd1306_convertRgb16ToRgb8Dither(uint8_t *dst, const uint8_t *src, lcduint_t count,
+                                      lcduint_t x, lcduint_t y);
+
+/**
+ * Converts RGB8 pixels to GRAY4 format.
+ * @param dst destination buffer of (count + 1) / 2 bytes
+ * @param src source buffer of count bytes
+ * @param count number of pixels to convert
+ */
+void ssd1306_convertRgb8ToGray4(uint8_t *dst, const uint8_t *src, lcduint_t count);
+
+/**
+ * Converts RGB16 pixels to GRAY4 format. Pixels are reduced to RGB8 colors first.
+ * @param dst destination buffer of (count + 1) / 2 bytes
+ * @param src source buffer of count * 2 bytes
+ * @param count number of pixels to convert
+ */
+void ssd1306_convertRgb16ToGray4(uint8_t *dst, const uint8_t *src, lcduint_t count);
+
+/**
+ * @copydoc ssd1306_convertRgb16ToGray4
+ * @param x horizontal position of the first pixel on the screen
+ * @param y vertical position of the row on the screen
+ */
+void ssd1306_convertRgb16ToGray4Dither(uint8_t *dst, const uint8_t *src, lcduint_t count,
+                                       lcduint_t x, lcduint_t y);
+
+/**
+ * Converts RGB8 pixels to MONO format. Pixels brighter than 50% are set.
+ * @param dst destination buffer of count bytes
+ * @param src source buffer of count bytes
+ * @param count number of pixels to convert
+ * @param bit bit number (0-7) in destination bytes to write pixels to
+ */
+void ssd1306_convertRgb8ToMono(uint8_t *dst, const uint8_t *src, lcduint_t count, uint8_t bit);
+
+/**
+ * Converts RGB8 pixels to MONO format with ordered dithering. Row is written to
+ * (y & 7) bit of destination bytes.
+ * @param dst destination buffer of count bytes
+ * @param src source buffer of count bytes
+ * @param count number of pixels to convert
+ * @param x horizontal position of the first pixel on the screen
+ * @param y vertical position of the row on the screen
+ */
+void ssd1306_convertRgb8ToMonoDither(uint8_t *dst, const uint8_t *src, lcduint_t count,
+                                     lcduint_t x, lcduint_t y);
+
+/**
+ * Converts RGB16 pixels to MONO format. Pixels brighter than 50% are set.
+ * @param dst destination buffer of count bytes
+ * @param src source buffer of count * 2 bytes
+ * @param count number of pixels to convert
+ * @param bit bit number (0-7) in destination bytes to write pixels to
+ */
+void ssd1306_convertRgb16ToMono(uint8_t *dst, const uint8_t *src, lcduint_t count, uint8_t bit);
+
+/**
+ * Converts RGB16 pixels to MONO format with ordered dithering. Row is written to
+ * (y & 7) bit of destination bytes.
+ * @param dst destination buffer of count bytes
+ * @param src source buffer of count * 2 bytes
+ * @param count number of pixels to convert
+ * @param x horizontal position of the first pixel on the screen
+ * @param y vertical position of the row on the screen
+ */
+void ssd1306_convertRgb16ToMonoDither(uint8_t *dst, const uint8_t *src, lcduint_t count,
+                                      lcduint_t x, lcduint_t y);
+
+/**
+ * Draws RGB16 buffer, located in SRAM, on monochrome display, converting pixels
+ * with ordered dithering. Buffer has the same format as NanoCanvas16 buffer.
+ *
+ * @param x - horizontal position in pixels
+ * @param y - vertical position in pixels (must be divided by 8)
+ * @param w - width of buffer in pixels
+ * @param h - height of buffer in pixels (must be divided by 8)
+ * @param buf - pointer to RGB16 data, located in SRAM.
+ */
+void ssd1306_drawBuffer16ToMono(lcdint_t x, lcdint_t y, lcduint_t w, lcduint_t h, const uint8_t *buf);
+
+/**
+ * Draws RGB16 buffer, located in SRAM, on monochrome display, taking into account
+ * pitch parameter. Refer to ssd1306_drawBuffer16ToMono().
+ *
+ * @param x - horizontal position in pixels
+ * @param y - vertical position in pixels (must be divided by 8)
+ * @param w - width of block to draw in pixels
+ * @param h - height of block to draw in pixels (must be divided by 8)
+ * @param pitch length of buffer line in bytes
+ * @param buf - pointer to RGB16 data, located in SRAM.
+ */
+void ssd1306_drawBufferEx16ToMono(lcdint_t x, lcdint_t y, lcduint_t w, lcduint_t h,
+                                  lcduint_t pitch, const uint8_t *buf);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
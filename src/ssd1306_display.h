@@ -0,0 +1,515 @@
+/*
+    MIT License
+
+    Copyright (c) 2019, Alexey Dynda
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+/**
+ * @file ssd1306_display.h Compile-time display driver templates
+ */
+
+#ifndef _SSD1306_DISPLAY_H_
+#define _SSD1306_DISPLAY_H_
+
+#include "ssd1306.h"
+#include "intf/ssd1306_interface.h"
+#include "intf/spi/ssd1306_spi.h"
+#include "lcd/ssd1306_commands.h"
+#include "lcd/ssd1331_commands.h"
+#include "lcd/ssd1351_commands.h"
+#include "ssd1306_hal/io.h"
+
+extern "C" uint8_t s_ssd1306_invertByte;
+
+/**
+ * @defgroup LCD_DISPLAY_TEMPLATES DISPLAY: compile-time display drivers
+ * @{
+ *
+ * @brief Template layer with display controller and bus, selected at compile time
+ *
+ * @details C API sends every byte via ssd1306_lcd and ssd1306_intf function pointers, so
+ *          any display can be connected to any bus at runtime. For fixed hardware this
+ *          pluggability is not needed. Display template takes controller and bus as
+ *          template parameters, so compiler inlines the whole drawing loop down to
+ *          bus registers access. Rows of pixels and fill patterns are passed to the bus
+ *          as buffers, so even IntfRuntime bus makes one indirect call per row, not per byte.
+ *
+ *          Available buses are IntfAvrSpi (AVR hardware spi), IntfArduinoSpi (SPI library
+ *          of any Arduino board, including ARM ones) and IntfRuntime (any bus, initialized
+ *          by C API). Any class with the same static functions can be used as a bus.
+ *
+ *          Display and bus are still initialized by C API, for example,
+ *          ssd1306_128x64_spi_init(), since initialization is not performance critical.
+ *          After that Display template functions can be freely mixed with C API functions.
+ *          C API itself is not built on top of the templates: it is compiled as C and
+ *          selects display driver at runtime by init function, so it would need runtime
+ *          driver and bus, which is exactly the function pointer dispatch it has now.
+ *
+ *          @code
+ *          typedef Display<DriverSsd1306, IntfAvrSpi> Oled;
+ *
+ *          ssd1306_128x64_spi_init(3, 4, 5);
+ *          Oled::drawBuffer(0, 0, 128, 64, buffer);
+ *          @endcode
+ */
+
+/**
+ * Bus, which sends data via currently initialized ssd1306_intf.
+ * Use it for buses, which have no compile-time implementation.
+ */
+class IntfRuntime
+{
+public:
+    /** Starts communication with the display */
+    static inline void start() { ssd1306_intf.start(); }
+
+    /** Ends communication with the display */
+    static inline void stop() { ssd1306_intf.stop(); }
+
+    /** Sends byte to the display */
+    static inline void send(uint8_t data) { ssd1306_intf.send(data); }
+
+    /** Sends bytes to the display */
+    static inline void sendBuffer(const uint8_t *buffer, uint16_t size) { ssd1306_intf.send_buffer(buffer, size); }
+
+    /** Starts transaction for sending commands */
+    static inline void commandStart() { ssd1306_commandStart(); }
+
+    /** Starts transaction for sending data */
+    static inline void dataStart() { ssd1306_dataStart(); }
+
+    /** Switches D/C line of spi bus: 0 for commands, 1 for data */
+    static inline void spiDataMode(uint8_t mode) { ssd1306_spiDataMode(mode); }
+};
+
+#if defined(CONFIG_AVR_SPI_AVAILABLE) && defined(CONFIG_AVR_SPI_ENABLE)
+/**
+ * AVR hardware spi bus. Bus must be initialized by ssd1306_spiInit() or any
+ * display spi init function, for example, ssd1306_128x64_spi_init().
+ */
+class IntfAvrSpi
+{
+public:
+    /** Starts communication with the display */
+    static inline void start()
+    {
+        if (s_ssd1306_cs >= 0)
+        {
+            digitalWrite(s_ssd1306_cs, LOW);
+        }
+    }
+
+    /** Ends communication with the display */
+    static inline void stop()
+    {
+        if (s_ssd1306_cs >= 0)
+        {
+            digitalWrite(s_ssd1306_cs, HIGH);
+        }
+    }
+
+    /** Sends byte to the display */
+    static inline void send(uint8_t data)
+    {
+        SPDR = data;
+        asm volatile("nop");
+        while((SPSR & (1<<SPIF))==0);
+    }
+
+    /** Sends bytes to the display */
+    static inline void sendBuffer(const uint8_t *buffer, uint16_t size)
+    {
+        while (size--)
+        {
+            send(*buffer);
+            buffer++;
+        }
+    }
+
+    /** Starts transaction for sending commands */
+    static inline void commandStart() { start(); spiDataMode(0); }
+
+    /** Starts transaction for sending data */
+    static inline void dataStart() { start(); spiDataMode(1); }
+
+    /** Switches D/C line of spi bus: 0 for commands, 1 for data */
+    static inline void spiDataMode(uint8_t mode) { ssd1306_spiDataMode(mode); }
+};
+#endif
+
+#if defined(ARDUINO) && defined(CONFIG_PLATFORM_SPI_AVAILABLE) && defined(CONFIG_PLATFORM_SPI_ENABLE)
+#include <SPI.h>
+
+/**
+ * Spi bus of Arduino SPI library. SPI.transfer() is called directly, so this bus
+ * is available on all Arduino boards, including ARM based ones. Bus must be
+ * initialized by ssd1306_spiInit() or any display spi init function.
+ */
+class IntfArduinoSpi
+{
+public:
+    /** Starts communication with the display */
+    static inline void start()
+    {
+        SPI.beginTransaction(SPISettings(s_ssd1306_spi_clock, MSBFIRST, SPI_MODE0));
+        if (s_ssd1306_cs >= 0)
+        {
+            digitalWrite(s_ssd1306_cs, LOW);
+        }
+    }
+
+    /** Ends communication with the display */
+    static inline void stop()
+    {
+        if (s_ssd1306_cs >= 0)
+        {
+            digitalWrite(s_ssd1306_cs, HIGH);
+        }
+        SPI.endTransaction();
+    }
+
+    /** Sends byte to the display */
+    static inline void send(uint8_t data) { SPI.transfer(data); }
+
+    /** Sends bytes to the display */
+    static inline void sendBuffer(const uint8_t *buffer, uint16_t size)
+    {
+        /* SPI.transfer(buffer, size) overwrites buffer content with received data */
+        while (size--)
+        {
+            SPI.transfer(*buffer);
+            buffer++;
+        }
+    }
+
+    /** Starts transaction for sending commands */
+    static inline void commandStart() { start(); spiDataMode(0); }
+
+    /** Starts transaction for sending data */
+    static inline void dataStart() { start(); spiDataMode(1); }
+
+    /** Switches D/C line of spi bus: 0 for commands, 1 for data */
+    static inline void spiDataMode(uint8_t mode) { ssd1306_spiDataMode(mode); }
+};
+#endif
+
+/**
+ * Monochrome ssd1306 controller in horizontal addressing mode.
+ * Provides the same functions as ssd1306_lcd for monochrome displays.
+ */
+template <class I>
+class DriverSsd1306
+{
+public:
+    /** Sets block in display GDRAM, x and w in pixels, y in pages */
+    static inline void setBlock(lcduint_t x, lcduint_t y, lcduint_t w)
+    {
+        I::commandStart();
+        I::send(SSD1306_COLUMNADDR);
+        I::send(x);
+        I::send(w ? (x + w - 1) : (ssd1306_lcd.width - 1));
+        I::send(SSD1306_PAGEADDR);
+        I::send(y);
+        I::send((ssd1306_lcd.height >> 3) - 1);
+        I::stop();
+        I::dataStart();
+    }
+
+    /** Moves to the next page of block. Not needed in horizontal addressing mode */
+    static inline void nextPage() { }
+
+    /** Sends 8 vertical monochrome pixels */
+    static inline void sendPixels1(uint8_t data) { I::send(data); }
+
+    /** Sends len bytes, each containing 8 vertical monochrome pixels */
+    static inline void sendPixelsBuffer1(const uint8_t *buffer, uint16_t len) { I::sendBuffer(buffer, len); }
+};
+
+/**
+ * Color ssd1331 controller in normal 8-bit mode without rotation.
+ * Use ssd1306_setMode(LCD_MODE_NORMAL) before drawing.
+ */
+template <class I>
+class DriverSsd1331
+{
+public:
+    /** Sets block in display GDRAM, all arguments in pixels */
+    static inline void setBlock(lcduint_t x, lcduint_t y, lcduint_t w)
+    {
+        uint8_t rx = w ? (x + w - 1) : (ssd1306_lcd.width - 1);
+        I::start();
+        I::spiDataMode(0);
+        I::send(SSD1331_COLUMNADDR);
+        I::send(x);
+        I::send(rx < ssd1306_lcd.width ? rx : (ssd1306_lcd.width - 1));
+        I::send(SSD1331_ROWADDR);
+        I::send(y);
+        I::send(ssd1306_lcd.height - 1);
+        I::spiDataMode(1);
+    }
+
+    /** Moves to the next page of block. Not needed in normal mode */
+    static inline void nextPage() { }
+
+    /** Sends RGB8 pixel */
+    static inline void sendPixels8(uint8_t data) { I::send(data); }
+
+    /** Sends len RGB8 pixels */
+    static inline void sendPixelsBuffer8(const uint8_t *buffer, uint16_t len) { I::sendBuffer(buffer, len); }
+
+    /**
+     * Fills rectangle using graphic acceleration of the controller.
+     * Acceleration command is sent by C driver via ssd1306_lcd.fill_rect, since it is
+     * sent once per rectangle and C driver knows, when acceleration is faster.
+     * @return 1 if rectangle is filled, 0 if pixels must be sent
+     */
+    static inline uint8_t fillRect(lcdint_t x1, lcdint_t y1, lcdint_t x2, lcdint_t y2, uint16_t color)
+    {
+        return ssd1306_lcd.fill_rect && ssd1306_lcd.fill_rect(x1, y1, x2, y2, color);
+    }
+};
+
+/**
+ * Color ssd1351 controller in normal 16-bit mode.
+ * Use ssd1306_setMode(LCD_MODE_NORMAL) before drawing.
+ */
+template <class I>
+class DriverSsd1351
+{
+public:
+    /** Sets block in display GDRAM, all arguments in pixels */
+    static inline void setBlock(lcduint_t x, lcduint_t y, lcduint_t w)
+    {
+        uint8_t rx = w ? (x + w - 1) : (ssd1306_lcd.width - 1);
+        I::start();
+        I::spiDataMode(0);
+        I::send(SSD1351_COLUMNADDR);
+        I::spiDataMode(1);  // According to datasheet all args must be passed in data mode
+        I::send(x);
+        I::send(rx < ssd1306_lcd.width ? rx : (ssd1306_lcd.width - 1));
+        I::spiDataMode(0);
+        I::send(SSD1351_ROWADDR);
+        I::spiDataMode(1);  // According to datasheet all args must be passed in data mode
+        I::send(y);
+        I::send(ssd1306_lcd.height - 1);
+        I::spiDataMode(0);
+        I::send(SSD1331_WRITEDATA);
+        I::spiDataMode(1);
+    }
+
+    /** Moves to the next page of block. Not needed in normal mode */
+    static inline void nextPage() { }
+
+    /** Sends RGB16 pixel */
+    static inline void sendPixels16(uint16_t data)
+    {
+        I::send(data >> 8);
+        I::send(data & 0xFF);
+    }
+
+    /** Sends RGB16 pixels, len is number of bytes: 2 bytes per pixel, high byte first */
+    static inline void sendPixelsBuffer16(const uint8_t *buffer, uint16_t len) { I::sendBuffer(buffer, len); }
+
+    /** The controller has no graphic acceleration, so pixels must be sent */
+    static inline uint8_t fillRect(lcdint_t, lcdint_t, lcdint_t, lcdint_t, uint16_t) { return 0; }
+};
+
+/**
+ * Display, which has controller D and bus I selected at compile time.
+ * Functions are the same as C API ones, but only those functions can be used,
+ * which are supported by the controller: drawBuffer() for monochrome controllers,
+ * drawBufferFast8() for 8-bit controllers, etc.
+ */
+template <template <class> class D, class I>
+class Display
+{
+public:
+    /** Controller driver, connected to the bus */
+    typedef D<I> Driver;
+
+    /** Bus of the display */
+    typedef I Interface;
+
+    /**
+     * Draws bitmap, located in SRAM, on monochrome display.
+     * Each byte represents 8 vertical pixels.
+     * @see ssd1306_drawBuffer()
+     *
+     * @param x - horizontal position in pixels
+     * @param y - vertical position in blocks (pixels/8)
+     * @param w - width of bitmap in pixels
+     * @param h - height of bitmap in pixels (must be divided by 8)
+     * @param buf - pointer to data, located in SRAM.
+     */
+    static void drawBuffer(lcduint_t x, lcduint_t y, lcduint_t w, lcduint_t h, const uint8_t *buf)
+    {
+        Driver::setBlock(x, y, w);
+        for (lcduint_t j = h >> 3; j > 0; j--)
+        {
+            if (!s_ssd1306_invertByte)
+            {
+                Driver::sendPixelsBuffer1(buf, w);
+                buf += w;
+            }
+            else
+            {
+                for (lcduint_t i = w; i > 0; i--)
+                {
+                    Driver::sendPixels1(s_ssd1306_invertByte ^ *buf++);
+                }
+            }
+            Driver::nextPage();
+        }
+        I::stop();
+    }
+
+    /**
+     * Fills monochrome display with pattern byte.
+     * @see ssd1306_fillScreen()
+     * @param fill_Data - byte to fill display with.
+     */
+    static void fillScreen(uint8_t fill_Data)
+    {
+        uint8_t chunk[FILL_CHUNK_SIZE];
+        memset(chunk, fill_Data ^ s_ssd1306_invertByte, sizeof(chunk));
+        Driver::setBlock(0, 0, 0);
+        for (lcduint_t m = ssd1306_lcd.height >> 3; m > 0; m--)
+        {
+            for (lcduint_t n = ssd1306_lcd.width; n > 0; )
+            {
+                lcduint_t len = n < sizeof(chunk) ? n : sizeof(chunk);
+                Driver::sendPixelsBuffer1(chunk, len);
+                n -= len;
+            }
+            Driver::nextPage();
+        }
+        I::stop();
+    }
+
+    /**
+     * Draws 8-bit bitmap, located in SRAM, on the display.
+     * @see ssd1306_drawBufferFast8()
+     *
+     * @param x - horizontal position in pixels
+     * @param y - vertical position in pixels
+     * @param w - width of bitmap in pixels
+     * @param h - height of bitmap in pixels
+     * @param data - pointer to data, located in SRAM.
+     */
+    static void drawBufferFast8(lcdint_t x, lcdint_t y, lcduint_t w, lcduint_t h, const uint8_t *data)
+    {
+        Driver::setBlock(x, y, w);
+        /* Bitmap has no pitch, so it is sent as single block */
+        for (uint32_t count = (uint32_t)w * h; count > 0; )
+        {
+            uint16_t len = count < BLOCK_SIZE ? count : BLOCK_SIZE;
+            Driver::sendPixelsBuffer8(data, len);
+            data += len;
+            count -= len;
+        }
+        I::stop();
+    }
+
+    /**
+     * Fills screen with RGB8 color.
+     * @see ssd1306_fillScreen8()
+     * @param color - RGB8 color to fill display with.
+     */
+    static void fillScreen8(uint8_t color)
+    {
+        if ( Driver::fillRect(0, 0, ssd1306_lcd.width - 1, ssd1306_lcd.height - 1, RGB8_TO_RGB16(color)) )
+        {
+            return;
+        }
+        uint8_t chunk[FILL_CHUNK_SIZE];
+        memset(chunk, color, sizeof(chunk));
+        Driver::setBlock(0, 0, 0);
+        for (uint32_t count = (uint32_t)ssd1306_lcd.width * ssd1306_lcd.height; count > 0; )
+        {
+            uint16_t len = count < sizeof(chunk) ? count : sizeof(chunk);
+            Driver::sendPixelsBuffer8(chunk, len);
+            count -= len;
+        }
+        I::stop();
+    }
+
+    /**
+     * Draws 16-bit bitmap, located in SRAM, on the display.
+     * @see ssd1306_drawBufferFast16()
+     *
+     * @param x - horizontal position in pixels
+     * @param y - vertical position in pixels
+     * @param w - width of bitmap in pixels
+     * @param h - height of bitmap in pixels
+     * @param data - pointer to data, located in SRAM: 2 bytes per pixel, high byte first.
+     */
+    static void drawBufferFast16(lcdint_t x, lcdint_t y, lcduint_t w, lcduint_t h, const uint8_t *data)
+    {
+        Driver::setBlock(x, y, w);
+        for (uint32_t count = ((uint32_t)w * h) << 1; count > 0; )
+        {
+            uint16_t len = count < BLOCK_SIZE ? count : BLOCK_SIZE;
+            Driver::sendPixelsBuffer16(data, len);
+            data += len;
+            count -= len;
+        }
+        I::stop();
+    }
+
+    /**
+     * Fills screen with RGB16 color.
+     * @see ssd1306_fillScreen16()
+     * @param color - RGB16 color to fill display with.
+     */
+    static void fillScreen16(uint16_t color)
+    {
+        if ( Driver::fillRect(0, 0, ssd1306_lcd.width - 1, ssd1306_lcd.height - 1, color) )
+        {
+            return;
+        }
+        uint8_t chunk[FILL_CHUNK_SIZE];
+        for (uint8_t i = 0; i < sizeof(chunk); i += 2)
+        {
+            chunk[i] = color >> 8;
+            chunk[i + 1] = color & 0xFF;
+        }
+        Driver::setBlock(0, 0, 0);
+        for (uint32_t count = ((uint32_t)ssd1306_lcd.width * ssd1306_lcd.height) << 1; count > 0; )
+        {
+            uint16_t len = count < sizeof(chunk) ? count : sizeof(chunk);
+            Driver::sendPixelsBuffer16(chunk, len);
+            count -= len;
+        }
+        I::stop();
+    }
+
+private:
+    /** Size of stack buffer with fill pattern, must be even */
+    static const uint8_t FILL_CHUNK_SIZE = 32;
+
+    /** Maximum number of bytes, passed to the bus at once, must be even */
+    static const uint16_t BLOCK_SIZE = 0x8000;
+};
+
+/**
+ * @}
+ */
+
+#endif
@@ -54,6 +54,7 @@ static void (*s_ssd1306_getCharBitmap)(uint16_t unicode, SCharInfo *info) = NULL
 
 static const uint8_t *ssd1306_getCharGlyph(char ch);
 static const uint8_t *ssd1306_getU16CharGlyph(uint16_t unicode);
+static void __ssd1306_newFormatGetBitmap(uint16_t unicode, SCharInfo *info);
 
 lcduint_t      ssd1306_displayHeight()
 {
@@ -78,6 +79,90 @@ static const uint8_t * ssd1306_readUnicodeRecord(SUnicodeBlockRecord *r, const u
     return (r->count > 0) ? (&p[3]): NULL;
 }
 
+#ifdef CONFIG_SSD1306_UNICODE_INDEX_SIZE
+
+#define UNICODE_INDEX_NONE  0xFF
+
+/** Unicode block, found in font table */
+typedef struct
+{
+    uint16_t start_code;  ///< unicode start code
+    uint8_t count;        ///< count of unicode chars in block
+    const uint8_t *data;  ///< block data, following unicode block record
+} SUnicodeBlockIndex;
+
+/* Blocks of primary [0] and secondary [1] font tables, sorted by start code */
+static SUnicodeBlockIndex s_unicodeIndex[2][CONFIG_SSD1306_UNICODE_INDEX_SIZE];
+/* Number of indexed blocks, or UNICODE_INDEX_NONE if the table must be searched linearly */
+static uint8_t s_unicodeIndexCount[2] = { UNICODE_INDEX_NONE, UNICODE_INDEX_NONE };
+
+static void ssd1306_buildUnicodeIndex(uint8_t table, const uint8_t *data, uint8_t newFormat)
+{
+    SUnicodeBlockIndex *index = s_unicodeIndex[table];
+    uint8_t count = 0;
+    s_unicodeIndexCount[table] = UNICODE_INDEX_NONE;
+    while (data)
+    {
+        SUnicodeBlockRecord r;
+        const uint8_t *block = ssd1306_readUnicodeRecord( &r, data );
+        if (!block)
+        {
+            break;
+        }
+        if (count >= CONFIG_SSD1306_UNICODE_INDEX_SIZE)
+        {
+            // Too many blocks: leave the table for linear search
+            return;
+        }
+        uint8_t i = count++;
+        while ( i && (index[i - 1].start_code > r.start_code) )
+        {
+            index[i] = index[i - 1];
+            i--;
+        }
+        index[i].start_code = r.start_code;
+        index[i].count = r.count;
+        index[i].data = block;
+        if (newFormat)
+        {
+            // skip jump table and block bitmap data
+            block += r.count * 4;
+            block += ((pgm_read_byte(&block[0]) << 8) | (pgm_read_byte(&block[1]))) + 2;
+        }
+        else
+        {
+            block += r.count * s_fixedFont.glyph_size;
+        }
+        data = block;
+    }
+    s_unicodeIndexCount[table] = count;
+}
+
+static const SUnicodeBlockIndex *ssd1306_findUnicodeBlock(uint8_t table, uint16_t unicode)
+{
+    const SUnicodeBlockIndex *index = s_unicodeIndex[table];
+    uint8_t low = 0;
+    uint8_t high = s_unicodeIndexCount[table];
+    while (low < high)
+    {
+        uint8_t mid = (low + high) >> 1;
+        if ( unicode < index[mid].start_code )
+        {
+            high = mid;
+        }
+        else if ( unicode >= index[mid].start_code + index[mid].count )
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            return &index[mid];
+        }
+    }
+    return NULL;
+}
+#endif
+
 
 void ssd1306_setSecondaryFont(const uint8_t * progmemUnicode)
 {
@@ -87,12 +172,83 @@ void ssd1306_setSecondaryFont(const uint8_t * progmemUnicode)
     {
         s_fixedFont.secondary_table += sizeof(SFontHeaderRecord);
     }
+#ifdef CONFIG_SSD1306_UNICODE_INDEX_SIZE
+    ssd1306_buildUnicodeIndex( 1, s_fixedFont.secondary_table,
+                               s_ssd1306_getCharBitmap == __ssd1306_newFormatGetBitmap );
+#endif
+#endif
+}
+
+#ifdef CONFIG_SSD1306_GLYPH_CACHE_SIZE
+
+#if (CONFIG_SSD1306_GLYPH_CACHE_SIZE < 2) || (CONFIG_SSD1306_GLYPH_CACHE_SIZE & (CONFIG_SSD1306_GLYPH_CACHE_SIZE - 1))
+#error "CONFIG_SSD1306_GLYPH_CACHE_SIZE must be power of 2"
+#endif
+
+/* Cache is 2-way set associative: each set holds 2 glyphs, and the least recently used one is replaced */
+#define GLYPH_CACHE_SETS  (CONFIG_SSD1306_GLYPH_CACHE_SIZE / 2)
+
+typedef struct
+{
+    const uint8_t *primary_table;
+#ifdef CONFIG_SSD1306_UNICODE_ENABLE
+    const uint8_t *secondary_table;
+#endif
+    uint16_t unicode;
+    SCharInfo info;
+} SGlyphCacheEntry;
+
+static SGlyphCacheEntry s_glyphCache[GLYPH_CACHE_SETS][2];
+/* Index of the least recently used entry in each set */
+static uint8_t s_glyphCacheLru[GLYPH_CACHE_SETS];
+
+static inline uint8_t ssd1306_glyphCacheMatch(const SGlyphCacheEntry *entry, uint16_t unicode)
+{
+    return (entry->unicode == unicode) && (entry->primary_table == s_fixedFont.primary_table)
+#ifdef CONFIG_SSD1306_UNICODE_ENABLE
+           && (entry->secondary_table == s_fixedFont.secondary_table)
 #endif
+           ;
+}
+
+void ssd1306_clearGlyphCache(void)
+{
+    for (uint16_t i = 0; i < GLYPH_CACHE_SETS; i++)
+    {
+        s_glyphCache[i][0].primary_table = NULL;
+        s_glyphCache[i][1].primary_table = NULL;
+    }
 }
+#endif
 
 void ssd1306_getCharBitmap(uint16_t unicode, SCharInfo *info)
 {
+#ifdef CONFIG_SSD1306_GLYPH_CACHE_SIZE
+    uint16_t set = (unicode ^ ((uintptr_t)s_fixedFont.primary_table >> 2)) & (GLYPH_CACHE_SETS - 1);
+    SGlyphCacheEntry *entry = s_glyphCache[set];
+    for (uint8_t way = 0; way < 2; way++)
+    {
+        if ( entry[way].primary_table && ssd1306_glyphCacheMatch( &entry[way], unicode ) )
+        {
+            s_glyphCacheLru[set] = way ^ 1;
+            *info = entry[way].info;
+            return;
+        }
+    }
+    uint8_t way = s_glyphCacheLru[set];
+    s_glyphCacheLru[set] = way ^ 1;
+    /* Font getters do not fill glyph field if the char is not found */
+    info->glyph = NULL;
+    s_ssd1306_getCharBitmap( unicode, info );
+    entry[way].primary_table = s_fixedFont.primary_table;
+#ifdef CONFIG_SSD1306_UNICODE_ENABLE
+    entry[way].secondary_table = s_fixedFont.secondary_table;
+#endif
+    entry[way].unicode = unicode;
+    entry[way].info = *info;
+#else
     return s_ssd1306_getCharBitmap( unicode, info );
+#endif
 }
 
 uint16_t ssd1306_unicode16FromUtf8(uint8_t ch)
@@ -122,6 +278,9 @@ void ssd1306_enableUtf8Mode(void)
 #ifdef CONFIG_SSD1306_UNICODE_ENABLE
     g_ssd1306_unicode = 1;
 #endif
+#ifdef CONFIG_SSD1306_GLYPH_CACHE_SIZE
+    ssd1306_clearGlyphCache();
+#endif
 }
 
 void ssd1306_enableAsciiMode(void)
@@ -129,6 +288,9 @@ void ssd1306_enableAsciiMode(void)
 #ifdef CONFIG_SSD1306_UNICODE_ENABLE
     g_ssd1306_unicode = 0;
 #endif
+#ifdef CONFIG_SSD1306_GLYPH_CACHE_SIZE
+    ssd1306_clearGlyphCache();
+#endif
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////////////
@@ -147,8 +309,17 @@ static const uint8_t *ssd1306_getCharGlyph(char ch)
 }
 
 #ifdef CONFIG_SSD1306_UNICODE_ENABLE
-static const uint8_t *ssd1306_searchCharGlyph(const uint8_t * unicode_table, uint16_t unicode)
+static const uint8_t *ssd1306_searchCharGlyph(uint8_t table, const uint8_t * unicode_table, uint16_t unicode)
 {
+#ifdef CONFIG_SSD1306_UNICODE_INDEX_SIZE
+    if ( s_unicodeIndexCount[table] != UNICODE_INDEX_NONE )
+    {
+        const SUnicodeBlockIndex *block = ssd1306_findUnicodeBlock( table, unicode );
+        return block ? &block->data[ (unicode - block->start_code) * s_fixedFont.glyph_size ] : NULL;
+    }
+#else
+    (void)table;
+#endif
     SUnicodeBlockRecord r;
     const uint8_t *data = unicode_table;
     // looking for required unicode table
@@ -187,11 +358,11 @@ static const uint8_t *ssd1306_getU16CharGlyph(uint16_t unicode)
         }
         if (s_fixedFont.primary_table)
         {
-            glyph = ssd1306_searchCharGlyph( s_fixedFont.primary_table, unicode );
+            glyph = ssd1306_searchCharGlyph( 0, s_fixedFont.primary_table, unicode );
         }
         if (!glyph && s_fixedFont.secondary_table)
         {
-            glyph = ssd1306_searchCharGlyph( s_fixedFont.secondary_table, unicode );
+            glyph = ssd1306_searchCharGlyph( 1, s_fixedFont.secondary_table, unicode );
         }
         if (!glyph)
         {
@@ -230,6 +401,15 @@ void ssd1306_setFixedFont(const uint8_t * progmemFont)
 #ifdef CONFIG_SSD1306_UNICODE_ENABLE
     s_fixedFont.secondary_table = NULL;
 #endif
+#ifdef CONFIG_SSD1306_UNICODE_INDEX_SIZE
+    // Only fonts of type 0x01 have primary table organized as unicode blocks
+    s_unicodeIndexCount[0] = UNICODE_INDEX_NONE;
+    if ( s_fixedFont.h.type == 0x01 )
+    {
+        ssd1306_buildUnicodeIndex( 0, s_fixedFont.primary_table, 0 );
+    }
+    s_unicodeIndexCount[1] = UNICODE_INDEX_NONE;
+#endif
 }
 
 void ssd1306_setFixedFont_oldStyle(const uint8_t * progmemFont)
@@ -241,12 +421,28 @@ void ssd1306_setFixedFont_oldStyle(const uint8_t * progmemFont)
     s_fixedFont.primary_table = progmemFont + 4;
     s_fixedFont.pages = (s_fixedFont.h.height + 7) >> 3;
     s_fixedFont.glyph_size = s_fixedFont.pages * s_fixedFont.h.width;
+#ifdef CONFIG_SSD1306_UNICODE_INDEX_SIZE
+    s_unicodeIndexCount[0] = UNICODE_INDEX_NONE;
+#endif
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////////////
 /// NEW FORMAT: 1.7.8 and later
 /// NEW FORMAT is supported only by latest versions of ssd1306 library
 
+/* data points to jump table (offset|offset|bytes|width) of the block, containing count chars */
+static void ssd1306_newFormatReadChar(const uint8_t *data, uint8_t count, uint16_t index, SCharInfo *info)
+{
+    data += index * 4;
+    uint16_t offset = (pgm_read_byte(&data[0]) << 8) | (pgm_read_byte(&data[1]));
+    uint8_t glyph_width = pgm_read_byte(&data[2]);
+    uint8_t glyph_height = pgm_read_byte(&data[3]);
+    info->width = glyph_width;
+    info->height = glyph_height;
+    info->spacing = glyph_width ? 1 : (s_fixedFont.h.width >> 1);
+    info->glyph = data + (count - index) * 4 + 2 + offset;
+}
+
 static void __ssd1306_newFormatGetBitmap(uint16_t unicode, SCharInfo *info)
 {
     if (info)
@@ -255,6 +451,28 @@ static void __ssd1306_newFormatGetBitmap(uint16_t unicode, SCharInfo *info)
         uint8_t table_index = 0;
 #endif
         const uint8_t *data = s_fixedFont.primary_table;
+#ifdef CONFIG_SSD1306_UNICODE_INDEX_SIZE
+        if ( (s_unicodeIndexCount[0] != UNICODE_INDEX_NONE)
+#ifdef CONFIG_SSD1306_UNICODE_ENABLE
+             && (!s_fixedFont.secondary_table || (s_unicodeIndexCount[1] != UNICODE_INDEX_NONE))
+#endif
+           )
+        {
+            const SUnicodeBlockIndex *block = ssd1306_findUnicodeBlock( 0, unicode );
+#ifdef CONFIG_SSD1306_UNICODE_ENABLE
+            if ( !block && s_fixedFont.secondary_table )
+            {
+                block = ssd1306_findUnicodeBlock( 1, unicode );
+            }
+#endif
+            info->glyph = NULL;
+            if ( block )
+            {
+                ssd1306_newFormatReadChar( block->data, block->count, unicode - block->start_code, info );
+            }
+            data = NULL;
+        }
+#endif
         while (data)
         {
             SUnicodeBlockRecord r;
@@ -280,16 +498,7 @@ static void __ssd1306_newFormatGetBitmap(uint16_t unicode, SCharInfo *info)
                 data += ((pgm_read_byte(&data[0]) << 8) | (pgm_read_byte(&data[1]))) + 2;
                 continue;
             }
-            /* At this point data points to jump table (offset|offset|bytes|width) */
-            unicode -= r.start_code;
-            data += unicode * 4;
-            uint16_t offset = (pgm_read_byte(&data[0]) << 8) | (pgm_read_byte(&data[1]));
-            uint8_t glyph_width = pgm_read_byte(&data[2]);
-            uint8_t glyph_height = pgm_read_byte(&data[3]);
-            info->width = glyph_width;
-            info->height = glyph_height;
-            info->spacing = glyph_width ? 1 : (s_fixedFont.h.width >> 1);
-            info->glyph = data + (r.count - unicode) * 4 + 2 + offset;
+            ssd1306_newFormatReadChar( data, r.count, unicode - r.start_code, info );
             break;
         }
         if (!info->glyph)
@@ -314,6 +523,10 @@ void ssd1306_setFreeFont(const uint8_t * progmemFont)
 #ifdef CONFIG_SSD1306_UNICODE_ENABLE
     s_fixedFont.secondary_table = NULL;
 #endif
+#ifdef CONFIG_SSD1306_UNICODE_INDEX_SIZE
+    ssd1306_buildUnicodeIndex( 0, s_fixedFont.primary_table, 1 );
+    s_unicodeIndexCount[1] = UNICODE_INDEX_NONE;
+#endif
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////////////
@@ -355,6 +568,9 @@ static void __ssd1306_squixFormatGetBitmap(uint16_t unicode, SCharInfo *info)
 
 void ssd1306_setSquixFont(const uint8_t * progmemFont)
 {
+#ifdef CONFIG_SSD1306_UNICODE_INDEX_SIZE
+    s_unicodeIndexCount[0] = UNICODE_INDEX_NONE;
+#endif
     s_fixedFont.h.type = SSD1306_SQUIX_FORMAT;
     s_fixedFont.h.width  = pgm_read_byte(&progmemFont[0]);
     s_fixedFont.h.height = pgm_read_byte(&progmemFont[1]);
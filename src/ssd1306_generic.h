@@ -83,7 +83,8 @@ void ssd1306_setFixedFont_oldStyle(const uint8_t * progmemFont);
  * By default, the font supports only first 128 - 32 ascii chars.
  * Please refer to github wiki on how to generate new fonts.
  * @param progmemFont - font to setup located in Flash area
- * @note This function supports new fonts of ssd1306 library 1.7.8 and above
+ * @note This function supports new fonts of ssd1306 library 1.7.8 and above, and
+ *       fonts with RLE compressed glyphs (generated by fontgenerator.py with -c option)
  */
 void ssd1306_setFreeFont(const uint8_t * progmemFont);
 
@@ -124,6 +125,17 @@ void ssd1306_setFont6x8(const uint8_t * progmemFont) __attribute__ ((deprecated)
  */
 void ssd1306_getCharBitmap(uint16_t ch, SCharInfo *info);
 
+#ifdef CONFIG_SSD1306_GLYPH_CACHE_SIZE
+/**
+ * @brief Drops all glyphs from glyph cache.
+ *
+ * The cache is keyed by font pointers and char code, so there is no need to call this function
+ * when switching fonts. Call it only if font data, located in RAM, are changed.
+ * @note CONFIG_SSD1306_GLYPH_CACHE_SIZE must be defined in UserSettings.h
+ */
+void ssd1306_clearGlyphCache(void);
+#endif
+
 /**
  * Enables utf8 support for all text-functions.
  * @note Unicode-16 only supported in text decoding functions.
@@ -71,6 +71,81 @@
 //#define CONFIG_ADAFRUIT_GFX_ENABLE
 #endif
 
+/**
+ * Define this macro if you need NanoEngine to skip sending tiles to the display, when
+ * their content is the same as already sent. The engine keeps 4-byte hash per tile,
+ * so this option is intended for systems with enough RAM.
+ */
+#ifndef CONFIG_NANO_ENGINE_TILE_HASH_ENABLE
+//#define CONFIG_NANO_ENGINE_TILE_HASH_ENABLE
+#endif
+
+/**
+ * Define this macro to maximum display width in pixels, NanoEngine tracks refresh areas for.
+ * NanoEngine keeps one refresh bit per tile, and by default tracks 16 tiles per row, which
+ * covers 128-pixel wide displays with 8x8 tiles. Tiles beyond are never refreshed. Define this
+ * macro for wider displays, for example 320 for ILI9341 with 8x8 tiles (40 tiles per row).
+ */
+#ifndef CONFIG_NANO_ENGINE_MAX_WIDTH
+//#define CONFIG_NANO_ENGINE_MAX_WIDTH 320
+#endif
+
+/**
+ * Define this macro to maximum number of tiles, NanoEngine merges to single region. Adjacent
+ * refreshed tiles of the same tiles row (and clean tiles between them, if sending them costs
+ * less than CONFIG_NANO_ENGINE_BLOCK_COST bytes) are sent to the display as single block,
+ * reducing number of set_block commands. Region buffer takes this number of tile buffers in RAM.
+ */
+#ifndef CONFIG_NANO_ENGINE_MERGE_TILES
+//#define CONFIG_NANO_ENGINE_MERGE_TILES 8
+#endif
+
+/**
+ * Define this macro if you need retained mode for direct draw 1-bit functions:
+ * drawing goes to 1 KiB shadow buffer, and only changed areas are sent to the display
+ * by ssd1306_flush(). This option is intended for systems with enough RAM.
+ */
+#ifndef CONFIG_SSD1306_SHADOW_BUFFER_ENABLE
+//#define CONFIG_SSD1306_SHADOW_BUFFER_ENABLE
+#endif
+
+/**
+ * Define this macro if you need to count bus traffic: bytes, transactions and D/C switches
+ * sent via ssd1306_intf. Use ssd1306_intfStatsEnable() to start counting.
+ */
+#ifndef CONFIG_SSD1306_INTERFACE_STATS_ENABLE
+//#define CONFIG_SSD1306_INTERFACE_STATS_ENABLE
+#endif
+
+/**
+ * Define this macro to number of glyphs (power of 2) to keep in glyph cache. The cache holds
+ * char information, found in font tables, so text functions do not search font tables for
+ * recently drawn chars. Each entry takes 12-40 bytes of RAM depending on platform.
+ */
+#ifndef CONFIG_SSD1306_GLYPH_CACHE_SIZE
+//#define CONFIG_SSD1306_GLYPH_CACHE_SIZE 32
+#endif
+
+/**
+ * Define this macro to maximum number of unicode blocks per font table to index. When font
+ * is set, unicode blocks of primary and secondary font tables are collected to sorted index,
+ * and glyphs are located by binary search instead of walking all blocks. Each index entry
+ * takes 5-16 bytes of RAM depending on platform. Tables with more blocks are searched linearly.
+ */
+#ifndef CONFIG_SSD1306_UNICODE_INDEX_SIZE
+//#define CONFIG_SSD1306_UNICODE_INDEX_SIZE 16
+#endif
+
+/**
+ * Define this macro to size of stack buffer in bytes (multiple of 16), used to send monochrome
+ * pixels to RGB16 displays. Each byte of monochrome data is expanded to 16 bytes, so larger
+ * buffer means fewer interface calls. Default value is 32 bytes on AVR and 256 bytes on
+ * other platforms.
+ */
+#ifndef CONFIG_SSD1306_MONO16_CHUNK_SIZE
+//#define CONFIG_SSD1306_MONO16_CHUNK_SIZE 256
+#endif
+
 /**
  * Define this macro if platform specific i2c interface is implemented in SSD1306 HAL.
  * If you use Arduino platform, this macro enables Arduino Wire library module for compilation.
@@ -111,6 +111,46 @@ static inline int  analogRead(int pin) { return 0; };
 void digitalWrite(int pin, int level);
 #endif
 
+#if defined(SDL_EMULATION) || defined(__KERNEL__)
+static inline int  ssd1306_platform_gpioChipInit(int8_t chipId) { return 0; };
+static inline void ssd1306_platform_gpioClose(void) { };
+static inline void ssd1306_platform_spiFlush(void) { };
+static inline void ssd1306_platform_i2cSetMaxMessageSize(uint16_t size) { };
+#else
+/**
+ * Switches gpio functions from sysfs interface to /dev/gpiochipN character device.
+ * After the call pin numbers, passed to the library, mean line offsets of the chip.
+ * Line handles are requested on first use of the pin and kept open until the
+ * interface is closed, so each digitalWrite() costs single ioctl() call.
+ * Call this function before display initialization.
+ * @param chipId number of gpio chip to use. Pass -1 to use default chip 0.
+ * @return 0 on success, negative value if gpio chip cannot be opened. In this case
+ *         sysfs interface remains in use.
+ */
+int ssd1306_platform_gpioChipInit(int8_t chipId);
+
+/**
+ * Releases all gpio lines, requested via gpio chip character device.
+ * The function is called automatically, when i2c or spi interface is closed.
+ */
+void ssd1306_platform_gpioClose(void);
+
+/**
+ * Sets max size of single i2c message for Linux i2c-dev interface. Long transactions
+ * are split into several messages, which are sent to the adapter via single I2C_RDWR
+ * call. Decrease the value if i2c adapter doesn't support long messages.
+ * @param size max message size in bytes, up to 4096. Default value is 1025, which
+ *        is enough to send control byte and the whole 128x64 monochrome frame.
+ */
+void ssd1306_platform_i2cSetMaxMessageSize(uint16_t size);
+
+/**
+ * Linux spidev interface sends data to the device in background thread.
+ * The function waits until all data, passed to the interface, are sent.
+ */
+void ssd1306_platform_spiFlush(void);
+#endif
+
 static inline void randomSeed(int seed) { };
 static inline void attachInterrupt(int pin, void (*interrupt)(void), int level) { };
 static inline uint8_t pgm_read_byte(const void *ptr) { return *((const uint8_t *)ptr); };
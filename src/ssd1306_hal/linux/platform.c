@@ -40,8 +40,11 @@
 #include <stdlib.h>
 #include <unistd.h>
 #include <sys/ioctl.h>
+#include <linux/i2c.h>
 #include <linux/i2c-dev.h>
 #include <linux/spi/spidev.h>
+#include <linux/gpio.h>
+#include <pthread.h>
 
 #if defined(CONFIG_PLATFORM_SPI_AVAILABLE) && defined(CONFIG_PLATFORM_SPI_ENABLE) \
     && !defined(SDL_EMULATION)
@@ -62,6 +65,7 @@
 
 #ifdef LINUX_SPI_AVAILABLE
 static void platform_spi_send_cache();
+static int platform_spi_set_dc(int level);
 #endif
 
 int gpio_export(int pin)
@@ -204,8 +208,102 @@ int gpio_write(int pin, int value)
 static uint8_t s_exported_pin[MAX_GPIO_COUNT] = {0};
 static uint8_t s_pin_mode[MAX_GPIO_COUNT] = {0};
 
+/* gpio chip character device. If it is not open, sysfs interface is used */
+static int s_gpio_chip_fd = -1;
+/* line handles for gpio chip, valid only if pin is marked as exported */
+static int s_gpio_line_fd[MAX_GPIO_COUNT];
+
+static int gpiochip_request(int pin, int dir)
+{
+    struct gpiohandle_request req;
+    memset(&req, 0, sizeof req);
+    req.lineoffsets[0] = pin;
+    req.lines = 1;
+    req.flags = IN == dir ? GPIOHANDLE_REQUEST_INPUT : GPIOHANDLE_REQUEST_OUTPUT;
+    strncpy(req.consumer_label, "ssd1306", sizeof(req.consumer_label) - 1);
+    if (s_exported_pin[pin])
+    {
+        /* Line direction can be changed only by requesting line again */
+        close(s_gpio_line_fd[pin]);
+        s_exported_pin[pin] = 0;
+    }
+    if (ioctl(s_gpio_chip_fd, GPIO_GET_LINEHANDLE_IOCTL, &req) < 0)
+    {
+        fprintf(stderr, "Failed to request gpio line[%d]: %s%s!\n",
+                pin, strerror (errno), getuid() == 0 ? "" : ", need to be root");
+        return -1;
+    }
+    s_gpio_line_fd[pin] = req.fd;
+    s_exported_pin[pin] = 1;
+    return 0;
+}
+
+static int gpiochip_write(int pin, int value)
+{
+    struct gpiohandle_data data;
+    memset(&data, 0, sizeof data);
+    data.values[0] = LOW == value ? 0 : 1;
+    if (ioctl(s_gpio_line_fd[pin], GPIOHANDLE_SET_LINE_VALUES_IOCTL, &data) < 0)
+    {
+        fprintf(stderr, "Failed to set gpio line value[%d]: %s!\n",
+                pin, strerror (errno));
+        return -1;
+    }
+    return 0;
+}
+
+int ssd1306_platform_gpioChipInit(int8_t chipId)
+{
+    char filename[24];
+    snprintf(filename, sizeof(filename), "/dev/gpiochip%d", chipId < 0 ? 0 : chipId);
+    int fd = open(filename, O_RDWR);
+    if (fd < 0)
+    {
+        fprintf(stderr, "Failed to open %s: %s%s!\n",
+                filename, strerror (errno), getuid() == 0 ? "" : ", need to be root");
+        return -1;
+    }
+    ssd1306_platform_gpioClose();
+    if (s_gpio_chip_fd >= 0)
+    {
+        close(s_gpio_chip_fd);
+    }
+    memset(s_exported_pin, 0, sizeof(s_exported_pin));
+    memset(s_pin_mode, 0, sizeof(s_pin_mode));
+    s_gpio_chip_fd = fd;
+    return 0;
+}
+
+void ssd1306_platform_gpioClose(void)
+{
+    if (s_gpio_chip_fd < 0)
+    {
+        return;
+    }
+    for (int pin = 0; pin < MAX_GPIO_COUNT; pin++)
+    {
+        if (s_exported_pin[pin])
+        {
+            close(s_gpio_line_fd[pin]);
+            s_exported_pin[pin] = 0;
+            s_pin_mode[pin] = 0;
+        }
+    }
+}
+
 void pinMode(int pin, int mode)
 {
+    if (s_gpio_chip_fd >= 0)
+    {
+        if (mode == OUTPUT || mode == INPUT)
+        {
+            if (gpiochip_request(pin, mode == OUTPUT ? OUT : IN) == 0)
+            {
+                s_pin_mode[pin] = mode == OUTPUT ? 1 : 0;
+            }
+        }
+        return;
+    }
     if (!s_exported_pin[pin])
     {
         if ( gpio_export(pin)<0 )
@@ -226,15 +324,21 @@ void pinMode(int pin, int mode)
     }
 }
 
-void digitalWrite(int pin, int level)
+static void platform_gpio_write(int pin, int level)
 {
-#ifdef LINUX_SPI_AVAILABLE
-    if (s_ssd1306_dc == pin)
+    if (s_gpio_chip_fd >= 0)
     {
-        platform_spi_send_cache();
+        if (!s_exported_pin[pin] || !s_pin_mode[pin])
+        {
+            pinMode(pin, OUTPUT);
+            if (!s_exported_pin[pin])
+            {
+                return;
+            }
+        }
+        gpiochip_write( pin, level );
+        return;
     }
-#endif
-
     if (!s_exported_pin[pin])
     {
         if ( gpio_export(pin)<0 )
@@ -250,6 +354,18 @@ void digitalWrite(int pin, int level)
     gpio_write( pin, level );
 }
 
+void digitalWrite(int pin, int level)
+{
+#ifdef LINUX_SPI_AVAILABLE
+    /* D/C line is controlled by spi interface, while it is open */
+    if ((s_ssd1306_dc == pin) && platform_spi_set_dc(level))
+    {
+        return;
+    }
+#endif
+    platform_gpio_write(pin, level);
+}
+
 #endif // SDL_EMULATION
 
 //////////////////////////////////////////////////////////////////////////////////
@@ -264,35 +380,95 @@ void digitalWrite(int pin, int level)
 
 static uint8_t s_sa = SSD1306_SA;
 static int     s_fd = -1;
-static uint8_t s_buffer[128];
-static uint8_t s_dataSize = 0;
+static uint8_t s_buffer[4096];
+static uint16_t s_dataSize = 0;
+/* i2c messages, located in s_buffer, to be sent via single I2C_RDWR call */
+static struct i2c_msg s_msgs[I2C_RDWR_IOCTL_MAX_MSGS];
+static uint8_t s_msgCount = 0;
+static uint16_t s_maxMessageSize = 1025; // control byte + 128x64 monochrome frame
+static uint8_t s_rdwrSupported = 0;
+/* First byte of transaction (control byte), repeated in every message of the transaction */
+static uint8_t s_control;
+static uint8_t s_controlSet = 0;
 
-static void platform_i2c_start(void)
+static void platform_i2c_flush(void)
 {
+    if (!s_msgCount)
+    {
+        return;
+    }
+    if (s_rdwrSupported)
+    {
+        struct i2c_rdwr_ioctl_data data = { .msgs = s_msgs, .nmsgs = s_msgCount };
+        if (ioctl(s_fd, I2C_RDWR, &data) < 0)
+        {
+            fprintf(stderr, "Failed to write to the i2c bus: %s.\n", strerror(errno));
+        }
+    }
+    else
+    {
+        for (uint8_t i = 0; i < s_msgCount; i++)
+        {
+            if (write(s_fd, s_msgs[i].buf, s_msgs[i].len) != (ssize_t)s_msgs[i].len)
+            {
+                fprintf(stderr, "Failed to write to the i2c bus: %s.\n", strerror(errno));
+            }
+        }
+    }
+    s_msgCount = 0;
     s_dataSize = 0;
 }
 
+static struct i2c_msg *platform_i2c_new_message(void)
+{
+    if (s_msgCount == I2C_RDWR_IOCTL_MAX_MSGS)
+    {
+        platform_i2c_flush();
+    }
+    struct i2c_msg *msg = &s_msgs[s_msgCount++];
+    msg->addr = s_sa;
+    msg->flags = 0;
+    msg->len = 0;
+    msg->buf = &s_buffer[s_dataSize];
+    return msg;
+}
+
+static void platform_i2c_start(void)
+{
+    s_controlSet = 0;
+    platform_i2c_new_message();
+}
+
 static void platform_i2c_stop(void)
 {
-    if (write(s_fd, s_buffer, s_dataSize) != s_dataSize)
+    if (s_msgCount && !s_msgs[s_msgCount - 1].len)
     {
-        fprintf(stderr, "Failed to write to the i2c bus: %s.\n", strerror(errno));
+        s_msgCount--;
     }
-    s_dataSize = 0;
+    platform_i2c_flush();
 }
 
 static void platform_i2c_send(uint8_t data)
 {
-    s_buffer[s_dataSize] = data;
-    s_dataSize++;
-    if (s_dataSize == sizeof(s_buffer))
+    struct i2c_msg *msg = &s_msgs[s_msgCount - 1];
+    if (!s_controlSet)
     {
-        /* Send function puts all data to internal buffer.  *
-         * Restart transmission if internal buffer is full. */
-        ssd1306_intf.stop();
-        ssd1306_intf.start();
-        ssd1306_intf.send(0x40);
+        s_control = data;
+        s_controlSet = 1;
+    }
+    else if ((msg->len >= s_maxMessageSize) || (s_dataSize >= sizeof(s_buffer)))
+    {
+        /* Continue transaction in new message, starting with the same control byte */
+        if ((size_t)s_dataSize + 2 > sizeof(s_buffer))
+        {
+            platform_i2c_flush();
+        }
+        msg = platform_i2c_new_message();
+        msg->buf[msg->len++] = s_control;
+        s_dataSize++;
     }
+    msg->buf[msg->len++] = data;
+    s_dataSize++;
 }
 
 static void platform_i2c_send_buffer(const uint8_t *buffer, uint16_t size)
@@ -304,6 +480,15 @@ static void platform_i2c_send_buffer(const uint8_t *buffer, uint16_t size)
     }
 }
 
+void ssd1306_platform_i2cSetMaxMessageSize(uint16_t size)
+{
+    if (size < 2)
+    {
+        size = 2;
+    }
+    s_maxMessageSize = size < sizeof(s_buffer) ? size : sizeof(s_buffer);
+}
+
 static void platform_i2c_close()
 {
     if (s_fd >= 0)
@@ -311,6 +496,7 @@ static void platform_i2c_close()
         close(s_fd);
         s_fd = -1;
     }
+    ssd1306_platform_gpioClose();
 }
 
 static void empty_function()
@@ -353,6 +539,10 @@ void ssd1306_platform_i2cInit(int8_t busId, uint8_t sa, ssd1306_platform_i2cConf
         fprintf(stderr, "Failed to acquire bus access and/or talk to slave.\n");
         return;
     }
+    unsigned long funcs = 0;
+    s_rdwrSupported = (ioctl(s_fd, I2C_FUNCS, &funcs) >= 0) && (funcs & I2C_FUNC_I2C);
+    s_msgCount = 0;
+    s_dataSize = 0;
     ssd1306_intf.start = platform_i2c_start;
     ssd1306_intf.stop = platform_i2c_stop;
     ssd1306_intf.send = platform_i2c_send;
@@ -398,12 +588,39 @@ void ssd1306_platform_i2cInit(int8_t busId, uint8_t sa, ssd1306_platform_i2cConf
 
 static int     s_spi_fd = -1;
 extern uint32_t s_ssd1306_spi_clock;
-static uint8_t s_spi_cache[1024];
-static int s_spi_cached_count = 0;
+
+/* Number of cache buffers. While one buffer is filled by the library, *
+ * the others can be sent to spi device by background thread.          */
+#ifndef LINUX_SPI_CACHE_COUNT
+#define LINUX_SPI_CACHE_COUNT  2
+#endif
+
+/* Max number of command/data segments in single cache buffer */
+#define LINUX_SPI_MAX_SEGMENTS 64
+
+/* Part of cache buffer, which must be sent with the same D/C line level */
+typedef struct
+{
+    uint16_t len;
+    uint8_t dc;
+} spi_segment_t;
+
+static uint8_t s_spi_cache[LINUX_SPI_CACHE_COUNT][1024];
+static spi_segment_t s_spi_segments[LINUX_SPI_CACHE_COUNT][LINUX_SPI_MAX_SEGMENTS];
+static uint8_t s_spi_segment_count[LINUX_SPI_CACHE_COUNT];
+static uint16_t s_spi_cached_count = 0;
+static uint8_t s_spi_dc = HIGH;  // D/C level requested by the library
+static int s_spi_dc_line = -1;   // actual D/C line level, -1 if unknown
+static uint8_t s_spi_head = 0;   // buffer being filled by the library
+static uint8_t s_spi_tail = 0;   // next buffer to be sent by the thread
+static uint8_t s_spi_queued = 0; // number of buffers waiting for transfer
+static uint8_t s_spi_thread_running = 0;
+static pthread_t s_spi_thread;
+static pthread_mutex_t s_spi_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t s_spi_cond = PTHREAD_COND_INITIALIZER;
 
 static void platform_spi_start(void)
 {
-    s_spi_cached_count = 0;
 }
 
 static void platform_spi_stop(void)
@@ -411,36 +628,156 @@ static void platform_spi_stop(void)
     platform_spi_send_cache();
 }
 
+/* Sends all segments of cache buffer, switching D/C line between them */
+static void platform_spi_transfer(uint8_t index)
+{
+    const uint8_t *data = s_spi_cache[index];
+    for (uint8_t i = 0; i < s_spi_segment_count[index]; i++)
+    {
+        const spi_segment_t *segment = &s_spi_segments[index][i];
+        if (!segment->len)
+        {
+            continue;
+        }
+        if (s_spi_dc_line != segment->dc)
+        {
+            platform_gpio_write(s_ssd1306_dc, segment->dc);
+            s_spi_dc_line = segment->dc;
+        }
+        struct spi_ioc_transfer mesg;
+        memset(&mesg, 0, sizeof mesg);
+        mesg.tx_buf = (unsigned long)data;
+        mesg.rx_buf = 0;
+        mesg.len = segment->len;
+        mesg.delay_usecs = 0;
+        mesg.speed_hz = 0;
+        mesg.bits_per_word = 8;
+        mesg.cs_change = 0;
+        if (ioctl(s_spi_fd, SPI_IOC_MESSAGE(1), &mesg) < 1)
+        {
+            fprintf(stderr, "SPI failed to send SPI message: %s\n", strerror (errno)) ;
+        }
+        data += segment->len;
+    }
+}
+
+static void *platform_spi_thread(void *arg)
+{
+    (void)arg;
+    pthread_mutex_lock(&s_spi_mutex);
+    for(;;)
+    {
+        while (!s_spi_queued && s_spi_thread_running)
+        {
+            pthread_cond_wait(&s_spi_cond, &s_spi_mutex);
+        }
+        if (!s_spi_queued)
+        {
+            break;
+        }
+        uint8_t index = s_spi_tail;
+        pthread_mutex_unlock(&s_spi_mutex);
+        /* The library doesn't touch queued buffers, so no lock is needed here */
+        platform_spi_transfer(index);
+        pthread_mutex_lock(&s_spi_mutex);
+        s_spi_tail = (s_spi_tail + 1) % LINUX_SPI_CACHE_COUNT;
+        s_spi_queued--;
+        pthread_cond_broadcast(&s_spi_cond);
+    }
+    pthread_mutex_unlock(&s_spi_mutex);
+    return NULL;
+}
+
+/* Starts new cache buffer with single empty segment */
+static void platform_spi_reset_cache(void)
+{
+    s_spi_cached_count = 0;
+    s_spi_segment_count[s_spi_head] = 1;
+    s_spi_segments[s_spi_head][0].len = 0;
+    s_spi_segments[s_spi_head][0].dc = s_spi_dc;
+}
+
+/* Passes filled buffer to background thread and switches to next free buffer */
 static void platform_spi_send_cache()
 {
-    /* TODO: Yeah, sending single bytes is too slow, but *
-     * need to figure out how to detect data/command bytes *
-     * to send bytes as one block */
     if ( s_spi_cached_count == 0 )
     {
         return;
     }
-    struct spi_ioc_transfer mesg;
-    memset(&mesg, 0, sizeof mesg);
-    mesg.tx_buf = (unsigned long)&s_spi_cache[0];
-    mesg.rx_buf = 0;
-    mesg.len = s_spi_cached_count;
-    mesg.delay_usecs = 0;
-    mesg.speed_hz = 0;
-    mesg.bits_per_word = 8;
-    mesg.cs_change = 0;
-    if (ioctl(s_spi_fd, SPI_IOC_MESSAGE(1), &mesg) < 1)
+    if (!s_spi_thread_running)
     {
-        fprintf(stderr, "SPI failed to send SPI message: %s\n", strerror (errno)) ;
+        platform_spi_transfer(s_spi_head);
+        platform_spi_reset_cache();
+        return;
     }
-    s_spi_cached_count = 0;
+    pthread_mutex_lock(&s_spi_mutex);
+    s_spi_head = (s_spi_head + 1) % LINUX_SPI_CACHE_COUNT;
+    s_spi_queued++;
+    pthread_cond_broadcast(&s_spi_cond);
+    while (s_spi_queued == LINUX_SPI_CACHE_COUNT)
+    {
+        pthread_cond_wait(&s_spi_cond, &s_spi_mutex);
+    }
+    pthread_mutex_unlock(&s_spi_mutex);
+    platform_spi_reset_cache();
+}
+
+/* Sends all cached data and waits until spi transfers are complete */
+static void platform_spi_flush(void)
+{
+    platform_spi_send_cache();
+    pthread_mutex_lock(&s_spi_mutex);
+    while (s_spi_queued)
+    {
+        pthread_cond_wait(&s_spi_cond, &s_spi_mutex);
+    }
+    pthread_mutex_unlock(&s_spi_mutex);
+}
+
+void ssd1306_platform_spiFlush(void)
+{
+    platform_spi_flush();
+}
+
+/* Instead of switching D/C line immediately, the function starts new segment *
+ * in the cache. D/C line is switched right before sending that segment.      */
+static int platform_spi_set_dc(int level)
+{
+    if (s_spi_fd < 0)
+    {
+        return 0;
+    }
+    level = level == LOW ? LOW : HIGH;
+    if (s_spi_dc == level)
+    {
+        return 1;
+    }
+    s_spi_dc = level;
+    spi_segment_t *segment = &s_spi_segments[s_spi_head][s_spi_segment_count[s_spi_head] - 1];
+    if (!segment->len)
+    {
+        segment->dc = level;
+    }
+    else if (s_spi_segment_count[s_spi_head] == LINUX_SPI_MAX_SEGMENTS)
+    {
+        platform_spi_send_cache();
+    }
+    else
+    {
+        segment++;
+        segment->len = 0;
+        segment->dc = level;
+        s_spi_segment_count[s_spi_head]++;
+    }
+    return 1;
 }
 
 static void platform_spi_send(uint8_t data)
 {
-    s_spi_cache[s_spi_cached_count] = data;
+    s_spi_cache[s_spi_head][s_spi_cached_count] = data;
     s_spi_cached_count++;
-    if ( s_spi_cached_count >= sizeof( s_spi_cache ) )
+    s_spi_segments[s_spi_head][s_spi_segment_count[s_spi_head] - 1].len++;
+    if ( s_spi_cached_count >= sizeof( s_spi_cache[0] ) )
     {
         platform_spi_send_cache();
     }
@@ -448,19 +785,41 @@ static void platform_spi_send(uint8_t data)
 
 static void platform_spi_close(void)
 {
+    platform_spi_flush();
+    if (s_spi_thread_running)
+    {
+        pthread_mutex_lock(&s_spi_mutex);
+        s_spi_thread_running = 0;
+        pthread_cond_broadcast(&s_spi_cond);
+        pthread_mutex_unlock(&s_spi_mutex);
+        pthread_join(s_spi_thread, NULL);
+    }
     if (s_spi_fd >= 0)
     {
         close(s_spi_fd);
         s_spi_fd = -1;
     }
+    ssd1306_platform_gpioClose();
 }
 
 static void platform_spi_send_buffer(const uint8_t *data, uint16_t len)
 {
-    while (len--)
+    while (len)
     {
-        platform_spi_send(*data);
-        data++;
+        uint16_t size = sizeof( s_spi_cache[0] ) - s_spi_cached_count;
+        if (size > len)
+        {
+            size = len;
+        }
+        memcpy(&s_spi_cache[s_spi_head][s_spi_cached_count], data, size);
+        s_spi_cached_count += size;
+        s_spi_segments[s_spi_head][s_spi_segment_count[s_spi_head] - 1].len += size;
+        data += size;
+        len -= size;
+        if ( s_spi_cached_count >= sizeof( s_spi_cache[0] ) )
+        {
+            platform_spi_send_cache();
+        }
     }
 }
 
@@ -520,6 +879,17 @@ void ssd1306_platform_spiInit(int8_t busId,
     {
         printf("Failed to set SPI BPW: %s!\n", strerror(errno));
     }
+    s_spi_head = 0;
+    s_spi_tail = 0;
+    s_spi_queued = 0;
+    s_spi_dc_line = -1;
+    platform_spi_reset_cache();
+    s_spi_thread_running = 1;
+    if (pthread_create(&s_spi_thread, NULL, platform_spi_thread, NULL) != 0)
+    {
+        /* Not critical: cached data will be sent synchronously */
+        s_spi_thread_running = 0;
+    }
 
     ssd1306_intf.spi = 1;
     ssd1306_intf.start = platform_spi_start;
@@ -0,0 +1,119 @@
+/*
+    MIT License
+
+    Copyright (c) 2019, Alexey Dynda
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include "ssd1306_rle.h"
+
+static void ssd1306_rleNextPacket(SRleDecoder *dec)
+{
+    uint8_t ctl = pgm_read_byte(dec->data++);
+    if ( !(ctl & 0x80) )
+    {
+        dec->literal = 1;
+        dec->count = ctl + 1;
+    }
+    else
+    {
+        dec->literal = 0;
+        dec->count = (ctl & 0x3F) + 1;
+        dec->value = (ctl & 0x40) ? pgm_read_byte(dec->data++) : 0x00;
+    }
+}
+
+void ssd1306_rleInit(SRleDecoder *dec, const uint8_t *data)
+{
+    dec->data = data;
+    dec->count = 0;
+    dec->value = 0;
+    dec->literal = 0;
+}
+
+uint8_t ssd1306_rleNext(SRleDecoder *dec)
+{
+    if ( !dec->count )
+    {
+        ssd1306_rleNextPacket(dec);
+    }
+    dec->count--;
+    return dec->literal ? pgm_read_byte(dec->data++) : dec->value;
+}
+
+uint8_t ssd1306_rlePeek(const SRleDecoder *dec)
+{
+    if ( dec->count )
+    {
+        return dec->literal ? pgm_read_byte(dec->data) : dec->value;
+    }
+    uint8_t ctl = pgm_read_byte(dec->data);
+    if ( (ctl & 0xC0) == 0x80 )
+    {
+        return 0x00;
+    }
+    return pgm_read_byte(dec->data + 1);
+}
+
+void ssd1306_rleSkip(SRleDecoder *dec, uint16_t count)
+{
+    while ( count )
+    {
+        if ( !dec->count )
+        {
+            ssd1306_rleNextPacket(dec);
+        }
+        uint8_t n = count < dec->count ? count : dec->count;
+        if ( dec->literal )
+        {
+            dec->data += n;
+        }
+        dec->count -= n;
+        count -= n;
+    }
+}
+
+void ssd1306_rleRead(SRleDecoder *dec, uint8_t *buf, uint16_t count)
+{
+    while ( count )
+    {
+        if ( !dec->count )
+        {
+            ssd1306_rleNextPacket(dec);
+        }
+        uint8_t n = count < dec->count ? count : dec->count;
+        dec->count -= n;
+        count -= n;
+        if ( dec->literal )
+        {
+            while (n--)
+            {
+                *buf++ = pgm_read_byte(dec->data++);
+            }
+        }
+        else
+        {
+            while (n--)
+            {
+                *buf++ = dec->value;
+            }
+        }
+    }
+}
@@ -0,0 +1,107 @@
+/*
+    MIT License
+
+    Copyright (c) 2019, Alexey Dynda
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+/**
+ * @file ssd1306_rle.h Streaming decoder for RLE compressed bitmaps and fonts
+ */
+
+#ifndef _SSD1306_RLE_H_
+#define _SSD1306_RLE_H_
+
+#include "ssd1306_hal/io.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup LCD_RLE_API RLE: Compressed bitmaps
+ * @{
+ *
+ * @brief Functions to decode RLE compressed monochrome bitmaps and font glyphs
+ *
+ * @details Compressed data is the stream of bytes in native ssd1306 format (page by page,
+ *          each byte represents 8 vertical pixels), packed into packets. Each packet
+ *          starts with control byte:
+ *          - 0x00-0x7F: (N & 0x7F) + 1 literal bytes follow the control byte
+ *          - 0x80-0xBF: (N & 0x3F) + 1 zero bytes, no data follows
+ *          - 0xC0-0xFF: (N & 0x3F) + 1 copies of the byte, following the control byte
+ *          Packets may cross page boundaries. Compressed data can be generated by
+ *          tools/fontgenerator.py (-c option) or by tools/modules/rle.py.
+ *          Decoder reads compressed data directly from Flash and doesn't need
+ *          any buffer for the whole image.
+ */
+
+/** RLE decoder state */
+typedef struct
+{
+    const uint8_t *data;  ///< next byte of compressed stream, located in Flash
+    uint8_t count;        ///< number of bytes left in current packet
+    uint8_t value;        ///< byte value for run packets
+    uint8_t literal;      ///< non-zero if current packet contains literal bytes
+} SRleDecoder;
+
+/**
+ * Prepares decoder to decode compressed stream
+ * @param dec decoder state
+ * @param data compressed data, located in Flash
+ */
+void ssd1306_rleInit(SRleDecoder *dec, const uint8_t *data);
+
+/**
+ * Returns next decoded byte
+ * @param dec decoder state
+ */
+uint8_t ssd1306_rleNext(SRleDecoder *dec);
+
+/**
+ * Returns next decoded byte without moving decoder forward
+ * @param dec decoder state
+ */
+uint8_t ssd1306_rlePeek(const SRleDecoder *dec);
+
+/**
+ * Skips specified number of decoded bytes.
+ * Whole packets are skipped without decoding.
+ * @param dec decoder state
+ * @param count number of decoded bytes to skip
+ */
+void ssd1306_rleSkip(SRleDecoder *dec, uint16_t count);
+
+/**
+ * Decodes specified number of bytes to buffer in RAM
+ * @param dec decoder state
+ * @param buf buffer in RAM to place decoded bytes to
+ * @param count number of bytes to decode
+ */
+void ssd1306_rleRead(SRleDecoder *dec, uint8_t *buf, uint16_t count);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
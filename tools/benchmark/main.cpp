@@ -0,0 +1,362 @@
+/*
+    MIT License
+
+    Copyright (c) 2019, Alexey Dynda
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+/*
+ * Host benchmark for canvas primitives, text output and direct draw functions.
+ * Display drivers are connected to null interface, so the results show pure
+ * cpu cost of the library without bus limits.
+ */
+
+#include "ssd1306.h"
+#include "nano_engine/canvas.h"
+#include "intf/ssd1306_interface.h"
+#include "intf/spi/ssd1306_spi.h"
+#include "ssd1306_display.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+typedef struct
+{
+    const char *name;
+    void (*setup)(void);
+    void (*run)(uint32_t i);
+} benchmark_t;
+
+static uint64_t s_bytes = 0;
+
+static void null_start(void) {}
+static void null_stop(void) {}
+static void null_send(uint8_t) { s_bytes++; }
+static void null_send_buffer(const uint8_t *, uint16_t size) { s_bytes += size; }
+static void null_close(void) {}
+
+static void null_interface(void)
+{
+    /* There is no real D/C pin */
+    s_ssd1306_dc = 0;
+    ssd1306_intf.spi = 0;
+    ssd1306_intf.start = null_start;
+    ssd1306_intf.stop = null_stop;
+    ssd1306_intf.send = null_send;
+    ssd1306_intf.send_buffer = null_send_buffer;
+    ssd1306_intf.close = null_close;
+}
+
+static const char s_text[] = "Hello, world!";
+static uint8_t s_bitmap[64 * 64 * 2];
+
+////////////////////////////////////////////////////////////////////////////
+//                             CANVAS PRIMITIVES
+////////////////////////////////////////////////////////////////////////////
+
+static uint8_t s_buffer1[128 * 64 / 8];
+static uint8_t s_buffer4[128 * 128 / 2];
+static uint8_t s_buffer8[128 * 128];
+static uint8_t s_buffer16[320 * 240 * 2];
+static const lcdint_t s_canvas1_width = 128, s_canvas1_height = 64;
+static const lcdint_t s_canvas4_width = 128, s_canvas4_height = 128;
+static const lcdint_t s_canvas8_width = 128, s_canvas8_height = 128;
+static const lcdint_t s_canvas16_width = 320, s_canvas16_height = 240;
+static NanoCanvas1 s_canvas1(128, 64, s_buffer1);
+static NanoCanvas1_4 s_canvas4(128, 128, s_buffer4);
+static NanoCanvas8 s_canvas8(128, 128, s_buffer8);
+static NanoCanvas16 s_canvas16(320, 240, s_buffer16);
+
+/* Coordinates change with every iteration, so that clipping and alignment cases are mixed */
+#define X(c, i)  ((lcdint_t)((i * 7) % c##_width) - 8)
+#define Y(c, i)  ((lcdint_t)((i * 5) % c##_height) - 8)
+
+#define CANVAS_COMMON(c, n) \
+    static void n##_putPixel(uint32_t i) { c.putPixel(X(c, i), Y(c, i)); } \
+    static void n##_drawHLine(uint32_t i) { c.drawHLine(X(c, i), Y(c, i), X(c, i) + 64); } \
+    static void n##_drawVLine(uint32_t i) { c.drawVLine(X(c, i), Y(c, i), Y(c, i) + 64); } \
+    static void n##_drawLine(uint32_t i) { c.drawLine(X(c, i), Y(c, i), X(c, i) + 40, Y(c, i) + 30); } \
+    static void n##_drawRect(uint32_t i) { c.drawRect(X(c, i), Y(c, i), X(c, i) + 40, Y(c, i) + 30); } \
+    static void n##_fillRect(uint32_t i) { c.fillRect(X(c, i), Y(c, i), X(c, i) + 40, Y(c, i) + 30); } \
+    static void n##_drawBitmap1(uint32_t i) { c.drawBitmap1(X(c, i), Y(c, i), 32, 32, s_bitmap); } \
+    static void n##_clear(uint32_t) { c.clear(); } \
+    static void n##_printFixed(uint32_t i) { c.printFixed(X(c, i), Y(c, i), s_text); } \
+    static void n##_setup(void) { c.setMode(0); c.setColor(0xFFFF); ssd1306_setFixedFont(ssd1306xled_font6x8); }
+
+#define CANVAS_XBITMAP1(c, n) \
+    static void n##_drawXBitmap1(uint32_t i) { c.drawXBitmap1(X(c, i), Y(c, i), 32, 32, s_bitmap); }
+
+#define CANVAS_BITMAP8(c, n) \
+    static void n##_drawBitmap8(uint32_t i) { c.drawBitmap8(X(c, i), Y(c, i), 32, 32, s_bitmap); }
+
+CANVAS_COMMON(s_canvas1, canvas1)
+CANVAS_XBITMAP1(s_canvas1, canvas1)
+CANVAS_COMMON(s_canvas4, canvas4)
+CANVAS_BITMAP8(s_canvas4, canvas4)
+CANVAS_COMMON(s_canvas8, canvas8)
+CANVAS_XBITMAP1(s_canvas8, canvas8)
+CANVAS_BITMAP8(s_canvas8, canvas8)
+CANVAS_COMMON(s_canvas16, canvas16)
+CANVAS_XBITMAP1(s_canvas16, canvas16)
+CANVAS_BITMAP8(s_canvas16, canvas16)
+
+#define BENCH(n, f)   { #n "." #f, n##_setup, n##_##f }
+
+////////////////////////////////////////////////////////////////////////////
+//                             DIRECT DRAW
+////////////////////////////////////////////////////////////////////////////
+
+static void direct1_setup(void)
+{
+    null_interface();
+    ssd1306_128x64_init();
+    ssd1306_setFixedFont(ssd1306xled_font6x8);
+}
+
+static void direct8_setup(void)
+{
+    null_interface();
+    ssd1331_96x64_init();
+    ssd1306_setMode(LCD_MODE_NORMAL);
+    ssd1306_setFixedFont(ssd1306xled_font6x8);
+    ssd1306_setColor(0xFF);
+}
+
+static void direct16_setup(void)
+{
+    null_interface();
+    ili9341_240x320_init();
+    ssd1306_setMode(LCD_MODE_NORMAL);
+    ssd1306_setFixedFont(ssd1306xled_font6x8);
+    ssd1306_setColor(0xFFFF);
+}
+
+static void direct1_drawBufferFast(uint32_t) { ssd1306_drawBufferFast(0, 0, 128, 64, s_bitmap); }
+static void direct1_printFixed(uint32_t) { ssd1306_printFixed(0, 8, s_text, STYLE_NORMAL); }
+static void direct1_putPixel(uint32_t i) { ssd1306_putPixel(i & 0x7F, i & 0x3F); }
+static void direct1_drawLine(uint32_t) { ssd1306_drawLine(0, 0, 127, 63); }
+static void direct1_blt(uint32_t) { s_canvas1.blt(0, 0); }
+
+static void direct8_drawBufferFast8(uint32_t) { ssd1306_drawBufferFast8(0, 0, 64, 64, s_bitmap); }
+static void direct8_printFixed8(uint32_t) { ssd1306_printFixed8(0, 8, s_text, STYLE_NORMAL); }
+static void direct8_fillRect8(uint32_t) { ssd1306_fillRect8(0, 0, 63, 63); }
+static void direct8_blt(uint32_t) { s_canvas8.blt(0, 0); }
+
+static void direct16_drawBufferFast16(uint32_t) { ssd1306_drawBufferFast16(0, 0, 64, 64, s_bitmap); }
+static void direct16_printFixed16(uint32_t) { ssd1306_printFixed16(0, 8, s_text, STYLE_NORMAL); }
+static void direct16_fillRect16(uint32_t) { ssd1306_fillRect16(0, 0, 63, 63); }
+static void direct16_blt(uint32_t) { s_canvas16.blt(0, 0); }
+
+////////////////////////////////////////////////////////////////////////////
+//                     COMPILE-TIME DISPLAY TEMPLATES
+////////////////////////////////////////////////////////////////////////////
+
+/* Null interface, known at compile time */
+class IntfNull
+{
+public:
+    static inline void start() {}
+    static inline void stop() {}
+    static inline void send(uint8_t) { s_bytes++; }
+    static inline void sendBuffer(const uint8_t *, uint16_t size) { s_bytes += size; }
+    static inline void commandStart() {}
+    static inline void dataStart() {}
+    static inline void spiDataMode(uint8_t) {}
+};
+
+/* The same drivers as direct1/direct8, but calls are resolved at compile time.    *
+ * display* use compile-time null interface, runtime* send via ssd1306_intf.       */
+typedef Display<DriverSsd1306, IntfNull> Display1;
+typedef Display<DriverSsd1331, IntfNull> Display8;
+typedef Display<DriverSsd1351, IntfNull> Display16;
+typedef Display<DriverSsd1306, IntfRuntime> Runtime1;
+typedef Display<DriverSsd1331, IntfRuntime> Runtime8;
+typedef Display<DriverSsd1351, IntfRuntime> Runtime16;
+
+static void display1_setup(void) { direct1_setup(); }
+static void display8_setup(void) { direct8_setup(); }
+static void runtime1_setup(void) { direct1_setup(); }
+static void runtime8_setup(void) { direct8_setup(); }
+
+static void display16_setup(void)
+{
+    null_interface();
+    ssd1351_128x128_init();
+    ssd1306_setMode(LCD_MODE_NORMAL);
+}
+
+static void runtime16_setup(void) { display16_setup(); }
+
+static void direct1_drawBuffer(uint32_t) { ssd1306_drawBuffer(0, 0, 128, 64, s_bitmap); }
+static void direct1_fillScreen(uint32_t i) { ssd1306_fillScreen(i); }
+static void direct8_fillScreen8(uint32_t i) { ssd1306_fillScreen8(i); }
+static void direct16_fillScreen16(uint32_t i) { ssd1306_fillScreen16(i); }
+
+#define DISPLAY_BENCHMARKS(n, D1, D8, D16) \
+    static void n##1_drawBuffer(uint32_t) { D1::drawBuffer(0, 0, 128, 64, s_bitmap); } \
+    static void n##1_fillScreen(uint32_t i) { D1::fillScreen(i); } \
+    static void n##8_drawBufferFast8(uint32_t) { D8::drawBufferFast8(0, 0, 64, 64, s_bitmap); } \
+    static void n##8_fillScreen8(uint32_t i) { D8::fillScreen8(i); } \
+    static void n##16_drawBufferFast16(uint32_t) { D16::drawBufferFast16(0, 0, 64, 64, s_bitmap); } \
+    static void n##16_fillScreen16(uint32_t i) { D16::fillScreen16(i); }
+
+DISPLAY_BENCHMARKS(display, Display1, Display8, Display16)
+DISPLAY_BENCHMARKS(runtime, Runtime1, Runtime8, Runtime16)
+
+static const benchmark_t s_benchmarks[] =
+{
+    BENCH(canvas1, putPixel), BENCH(canvas1, drawHLine), BENCH(canvas1, drawVLine),
+    BENCH(canvas1, drawLine), BENCH(canvas1, drawRect), BENCH(canvas1, fillRect),
+    BENCH(canvas1, drawBitmap1), BENCH(canvas1, drawXBitmap1), BENCH(canvas1, clear),
+    BENCH(canvas1, printFixed),
+
+    BENCH(canvas4, putPixel), BENCH(canvas4, drawHLine), BENCH(canvas4, drawVLine),
+    BENCH(canvas4, drawLine), BENCH(canvas4, drawRect), BENCH(canvas4, fillRect),
+    BENCH(canvas4, drawBitmap1), BENCH(canvas4, drawBitmap8), BENCH(canvas4, clear),
+    BENCH(canvas4, printFixed),
+
+    BENCH(canvas8, putPixel), BENCH(canvas8, drawHLine), BENCH(canvas8, drawVLine),
+    BENCH(canvas8, drawLine), BENCH(canvas8, drawRect), BENCH(canvas8, fillRect),
+    BENCH(canvas8, drawBitmap1), BENCH(canvas8, drawXBitmap1), BENCH(canvas8, drawBitmap8),
+    BENCH(canvas8, clear), BENCH(canvas8, printFixed),
+
+    BENCH(canvas16, putPixel), BENCH(canvas16, drawHLine), BENCH(canvas16, drawVLine),
+    BENCH(canvas16, drawLine), BENCH(canvas16, drawRect), BENCH(canvas16, fillRect),
+    BENCH(canvas16, drawBitmap1), BENCH(canvas16, drawXBitmap1), BENCH(canvas16, drawBitmap8),
+    BENCH(canvas16, clear), BENCH(canvas16, printFixed),
+
+    BENCH(direct1, drawBufferFast), BENCH(direct1, printFixed), BENCH(direct1, putPixel),
+    BENCH(direct1, drawLine), BENCH(direct1, blt), BENCH(direct1, drawBuffer),
+    BENCH(direct1, fillScreen),
+
+    BENCH(direct8, drawBufferFast8), BENCH(direct8, printFixed8), BENCH(direct8, fillRect8),
+    BENCH(direct8, blt), BENCH(direct8, fillScreen8),
+
+    BENCH(direct16, drawBufferFast16), BENCH(direct16, printFixed16), BENCH(direct16, fillRect16),
+    BENCH(direct16, blt), BENCH(direct16, fillScreen16),
+
+    BENCH(display1, drawBuffer), BENCH(display1, fillScreen),
+    BENCH(display8, drawBufferFast8), BENCH(display8, fillScreen8),
+    BENCH(display16, drawBufferFast16), BENCH(display16, fillScreen16),
+
+    BENCH(runtime1, drawBuffer), BENCH(runtime1, fillScreen),
+    BENCH(runtime8, drawBufferFast8), BENCH(runtime8, fillScreen8),
+    BENCH(runtime16, drawBufferFast16), BENCH(runtime16, fillScreen16),
+};
+
+////////////////////////////////////////////////////////////////////////////
+//                             RUNNER
+////////////////////////////////////////////////////////////////////////////
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static void usage(const char *name)
+{
+    fprintf(stderr, "Usage: %s [-f csv|json] [-t min_time_ms] [filter]\n", name);
+    fprintf(stderr, "    -f csv|json   output format (csv by default)\n");
+    fprintf(stderr, "    -t ms         minimal run time of each benchmark (200 ms by default)\n");
+    fprintf(stderr, "    filter        run only benchmarks, containing filter in the name\n");
+}
+
+int main(int argc, char *argv[])
+{
+    int json = 0;
+    uint64_t minTime = 200;
+    const char *filter = NULL;
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "-f") && i + 1 < argc)
+        {
+            json = !strcmp(argv[++i], "json");
+        }
+        else if (!strcmp(argv[i], "-t") && i + 1 < argc)
+        {
+            minTime = strtoul(argv[++i], NULL, 10);
+        }
+        else if (argv[i][0] == '-')
+        {
+            usage(argv[0]);
+            return 1;
+        }
+        else
+        {
+            filter = argv[i];
+        }
+    }
+    minTime *= 1000000ULL;
+    for (unsigned i = 0; i < sizeof(s_bitmap); i++)
+    {
+        s_bitmap[i] = (uint8_t)(i * 37 + (i >> 3));
+    }
+    null_interface();
+    if (json) printf("[\n");
+    else printf("name,iterations,ns_per_op,bytes_per_op\n");
+    int first = 1;
+    for (unsigned n = 0; n < sizeof(s_benchmarks) / sizeof(s_benchmarks[0]); n++)
+    {
+        const benchmark_t *b = &s_benchmarks[n];
+        if (filter && !strstr(b->name, filter))
+        {
+            continue;
+        }
+        b->setup();
+        uint32_t iterations = 1;
+        uint64_t elapsed;
+        for (;;)
+        {
+            s_bytes = 0;
+            uint64_t start = now_ns();
+            for (uint32_t i = 0; i < iterations; i++)
+            {
+                b->run(i);
+            }
+            elapsed = now_ns() - start;
+            if (elapsed >= minTime || iterations >= 0x40000000)
+            {
+                break;
+            }
+            /* Estimate number of iterations, required to run for minTime */
+            uint64_t next = elapsed ? (iterations * minTime * 6 / 5 / elapsed) : (uint64_t)iterations * 100;
+            iterations = next > iterations * 100ULL ? iterations * 100 : (next > iterations ? (uint32_t)next : iterations * 2);
+        }
+        double nsPerOp = (double)elapsed / iterations;
+        double bytesPerOp = (double)s_bytes / iterations;
+        if (json)
+        {
+            printf("%s  {\"name\": \"%s\", \"iterations\": %u, \"ns_per_op\": %.2f, \"bytes_per_op\": %.1f}",
+                   first ? "" : ",\n", b->name, iterations, nsPerOp, bytesPerOp);
+        }
+        else
+        {
+            printf("%s,%u,%.2f,%.1f\n", b->name, iterations, nsPerOp, bytesPerOp);
+        }
+        first = 0;
+        fflush(stdout);
+    }
+    if (json) printf("\n]\n");
+    return 0;
+}
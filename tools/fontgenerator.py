@@ -53,6 +53,7 @@ def print_help_and_exit():
     print("                      <E> - chars count minus 1 (integer), or char symbol")
     print("      -f old    old format 1.7.6 and below")
     print("      -f new    new format 1.7.8 and above")
+    print("      -c        compress glyphs with RLE (new format only)")
     print("      -d        Print demo text to console")
     print("      -t text   Use text as demo text")
     print("      --demo-only Prints demo text to console and exits")
@@ -61,6 +62,8 @@ def print_help_and_exit():
     print("      ttf_fonts.py --ttf FreeSans.ttf -s 8 -f old > font.h")
     print("   [convert ttf font to new format with demo text and print to console]")
     print("      ttf_fonts.py --ttf FreeSans.ttf -d -f new")
+    print("   [convert ttf font to new format with RLE compressed glyphs]")
+    print("      ttf_fonts.py --ttf FreeSans.ttf -s 16 -f new -c > font.h")
     print("   [convert GLCD font generated file to new format]")
     print("      ttf_fonts.py --glcd font.c -f new > font.h")
     exit(1)
@@ -70,6 +73,7 @@ if len(sys.argv) < 2:
 
 fsize = 8
 fold = False
+fcompressed = False
 flimit_bottom = 0
 fwidth = False
 fheight = False
@@ -108,6 +112,8 @@ while idx < len(sys.argv):
         idx += 1
         if sys.argv[idx] == "old":
             fold = True
+    elif opt == "-c":
+        fcompressed = True
     elif opt == "-g":
         idx += 1
         _start_char = sys.argv[idx]
@@ -184,5 +190,5 @@ else:
         else:
             source.printString(demo_text_)
     if generate_font:
-        font.generate_new_format()
+        font.generate_new_format(fcompressed)
 
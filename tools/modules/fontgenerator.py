@@ -31,6 +31,7 @@
 
 from __future__ import print_function
 import sys
+from modules import rle
 
 class Generator:
     source = None
@@ -76,14 +77,28 @@ class Generator:
         print("#endif")
         print("};")
 
-    def generate_new_format(self):
+    def _char_data(self, char, height):
+        bitmap = self.source.charBitmap(char)
+        result = []
+        for row in range(int((height + 7) / 8)):
+            for x in range(len(bitmap[0])):
+                data = 0
+                for i in range(8):
+                    y = row * 8 + i
+                    if y >= len(bitmap):
+                        break
+                    data |= (bitmap[y][x] << i)
+                result.append(data)
+        return result
+
+    def generate_new_format(self, compressed = False):
         total_size = 4
         self.source.expand_chars_top()
         print("extern const uint8_t %s[] PROGMEM;" % ("free_" + self.source.name))
         print("const uint8_t %s[] PROGMEM =" % ("free_" + self.source.name))
         print("{")
         print("//  type|width|height|first char")
-        print("    0x%02X, 0x%02X, 0x%02X, 0x%02X," % (2, self.source.width, self.source.height, 0x00))
+        print("    0x%02X, 0x%02X, 0x%02X, 0x%02X," % (4 if compressed else 2, self.source.width, self.source.height, 0x00))
         for group in range(self.source.groups_count()):
             chars = self.source.get_group_chars(group)
             total_size += 3
@@ -97,8 +112,7 @@ class Generator:
                  ((ord(chars[0]) >> 8) & 0xFF, ord(chars[0]) & 0xFF, len(chars) & 0xFF))
             # jump table
             offset = 0
-            heights = []
-            sizes = []
+            glyphs = []
             for char in chars:
                 bitmap = self.source.charBitmap(char)
                 print("    ", end = '')
@@ -106,44 +120,34 @@ class Generator:
                 height = len(bitmap)
                 while (height > 0) and (sum(bitmap[height -1]) == 0):
                     height -= 1
-                heights.append( height )
-                size = int((height + 7) / 8) * width
-                sizes.append( size )
+                data = self._char_data(char, height)
+                if int((height + 7) / 8) * width != len(data):
+                    print("ERROR!!!!")
+                    exit(1)
+                if compressed:
+                    data = rle.compress(data)
+                glyphs.append( data )
                 total_size += 4
                 print("0x%02X, 0x%02X, 0x%02X, 0x%02X," % (offset >> 8, offset & 0xFF, width, height), end = '')
                 if sys.version_info < (3, 0):
                     print("// char '%s' (0x%04X/%d)" % (char.encode("utf-8"), ord(char), ord(char)))
                 else:
                     print("// char '%s' (0x%04X/%d)" % (char, ord(char), ord(char)))
-                offset += size
+                offset += len(data)
             total_size += 2
             print("    0x%02X, 0x%02X," % (offset >> 8, offset & 0xFF))
             # char data
             for index in range(len(chars)):
                 char = chars[index]
-                bitmap = self.source.charBitmap(char)
                 print ("    ", end='')
-                size = 0
-                for row in range(int((heights[index] + 7) / 8)):
-                    for x in range(len(bitmap[0])):
-                        data = 0
-                        for i in range(8):
-                            y = row * 8 + i
-                            if y >= len(bitmap):
-                                break
-                            data |= (self.source.charBitmap(char)[y][x] << i)
-                        total_size += 1
-                        size += 1
-                        print("0x%02X," % data, end=' ')
+                for data in glyphs[index]:
+                    total_size += 1
+                    print("0x%02X," % data, end=' ')
                 if sys.version_info < (3, 0):
                     print("// char '%s' (0x%04X/%d)" % (char.encode("utf-8"), ord(char), ord(char)))
                 else:
                     print("// char '%s' (0x%04X/%d)" % (char, ord(char), ord(char)))
-                if size != sizes[index]:
-                    print("ERROR!!!!")
-                    exit(1)
         total_size += 3
         print("    0x00, 0x00, 0x00, // end of unicode tables")
         print("    // FONT REQUIRES %d BYTES" % (total_size))
         print("};")
-
@@ -0,0 +1,73 @@
+# -*- coding: UTF-8 -*-
+#    MIT License
+#
+#    Copyright (c) 2019, Alexey Dynda
+#
+#    Permission is hereby granted, free of charge, to any person obtaining a copy
+#    of this software and associated documentation files (the "Software"), to deal
+#    in the Software without restriction, including without limitation the rights
+#    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+#    copies of the Software, and to permit persons to whom the Software is
+#    furnished to do so, subject to the following conditions:
+#
+#    The above copyright notice and this permission notice shall be included in all
+#    copies or substantial portions of the Software.
+#
+#    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+#    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+#    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+#    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+#    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+#    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+#    SOFTWARE.
+#
+###################################################################################
+# RLE compression of bitmaps in native ssd1306 format.
+# Refer to src/ssd1306_rle.h for the description of the packets.
+
+def compress(data):
+    result = []
+    literal = []
+
+    def flush_literal():
+        while len(literal) > 0:
+            chunk = literal[:128]
+            del literal[:128]
+            result.append(len(chunk) - 1)
+            result.extend(chunk)
+
+    index = 0
+    while index < len(data):
+        value = data[index]
+        run = 1
+        while (index + run < len(data)) and (data[index + run] == value) and (run < 64):
+            run += 1
+        # zero run costs 1 byte, other runs cost 2 bytes
+        if (value == 0 and run >= 2) or run >= 3:
+            flush_literal()
+            if value == 0:
+                result.append(0x80 | (run - 1))
+            else:
+                result.extend([0xC0 | (run - 1), value])
+            index += run
+        else:
+            literal.append(value)
+            index += 1
+    flush_literal()
+    return result
+
+def decompress(data, size):
+    result = []
+    index = 0
+    while len(result) < size:
+        ctl = data[index]
+        index += 1
+        if ctl & 0x80 == 0:
+            result.extend(data[index:index + ctl + 1])
+            index += ctl + 1
+        elif ctl & 0x40 == 0:
+            result.extend([0] * ((ctl & 0x3F) + 1))
+        else:
+            result.extend([data[index]] * ((ctl & 0x3F) + 1))
+            index += 1
+    return result[:size]
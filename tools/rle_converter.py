@@ -0,0 +1,163 @@
+#!/usr/bin/python
+# -*- coding: UTF-8 -*-
+#    MIT License
+#
+#    Copyright (c) 2019, Alexey Dynda
+#
+#    Permission is hereby granted, free of charge, to any person obtaining a copy
+#    of this software and associated documentation files (the "Software"), to deal
+#    in the Software without restriction, including without limitation the rights
+#    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+#    copies of the Software, and to permit persons to whom the Software is
+#    furnished to do so, subject to the following conditions:
+#
+#    The above copyright notice and this permission notice shall be included in all
+#    copies or substantial portions of the Software.
+#
+#    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+#    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+#    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+#    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+#    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+#    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+#    SOFTWARE.
+#
+###################################################################################
+# Converts fonts and bitmaps, located in C source files, to RLE compressed format.
+# Refer to font_format.txt and src/ssd1306_rle.h for the description of the format.
+
+from __future__ import print_function
+import re
+import sys
+from modules import rle
+
+def print_help_and_exit():
+    print("Usage: rle_converter.py font|bitmap file.c name > outputFile")
+    print("   font    converts fixed font (type 0, 1) or free font (type 2)")
+    print("           to free font with RLE compressed glyphs (type 4)")
+    print("   bitmap  compresses bitmap in native ssd1306 format")
+    print("Examples:")
+    print("   rle_converter.py font ../src/ssd1306_fonts.c comic_sans_font24x32_123 > font.h")
+    print("   rle_converter.py bitmap sprites.cpp heartImage > bitmap.h")
+    print("Note: fixed fonts, converted to free font format, get 1 pixel spacing between chars")
+    exit(1)
+
+def read_array(filename, name):
+    with open(filename) as f:
+        content = f.read()
+    content = re.sub(r'/\*.*?\*/', '', content, flags=re.DOTALL)
+    content = re.sub(r'//[^\n]*', '', content)
+    # Take first branch of preprocessor conditions (unicode enabled for fixed fonts)
+    lines = []
+    state = []
+    for line in content.split('\n'):
+        stripped = line.strip()
+        if stripped.startswith('#if'):
+            state.append(True)
+        elif stripped.startswith('#else'):
+            state[-1] = not state[-1]
+        elif stripped.startswith('#endif'):
+            state.pop()
+        elif all(state):
+            lines.append(line)
+    content = '\n'.join(lines)
+    match = re.search(r'\b' + re.escape(name) + r'\s*\[\s*\]\s*(PROGMEM)?\s*=\s*\{(.*?)\};', content, re.DOTALL)
+    if match is None:
+        print("Array %s is not found in %s" % (name, filename), file=sys.stderr)
+        exit(1)
+    return [int(x, 0) for x in re.findall(r'0[xX][0-9a-fA-F]+|\d+', match.group(2))]
+
+def print_bytes(data, comment = None):
+    for i in range(0, len(data), 16):
+        print("    " + " ".join("0x%02X," % x for x in data[i:i+16]), end='')
+        if comment is not None and i == 0:
+            print(" // %s" % comment, end='')
+        print("")
+
+# Returns list of groups: (first unicode, [(width, height, glyph data), ...])
+def parse_font(data):
+    font_type, width, height, first_char = data[0:4]
+    groups = []
+    if font_type == 0:
+        size = width * int((height + 7) / 8)
+        count = int((len(data) - 4) / size)
+        glyphs = [ (width, height, data[4 + i * size: 4 + (i + 1) * size]) for i in range(count) ]
+        groups.append( (first_char, glyphs) )
+    elif font_type == 1:
+        size = width * int((height + 7) / 8)
+        index = 4
+        while (index + 2 < len(data)) and (data[index + 2] != 0):
+            code = (data[index] << 8) | data[index + 1]
+            count = data[index + 2]
+            index += 3
+            glyphs = [ (width, height, data[index + i * size: index + (i + 1) * size]) for i in range(count) ]
+            index += count * size
+            groups.append( (code, glyphs) )
+    elif font_type == 2:
+        index = 4
+        while (index + 2 < len(data)) and (data[index + 2] != 0):
+            code = (data[index] << 8) | data[index + 1]
+            count = data[index + 2]
+            index += 3
+            table = index
+            index += count * 4 + 2
+            glyphs = []
+            for i in range(count):
+                offset = (data[table + i * 4] << 8) | data[table + i * 4 + 1]
+                w = data[table + i * 4 + 2]
+                h = data[table + i * 4 + 3]
+                size = w * int((h + 7) / 8)
+                glyphs.append( (w, h, data[index + offset: index + offset + size]) )
+            index += (data[table + count * 4] << 8) | data[table + count * 4 + 1]
+            groups.append( (code, glyphs) )
+    else:
+        print("Unsupported font type %d" % font_type, file=sys.stderr)
+        exit(1)
+    return (width, height, groups)
+
+def convert_font(name, data):
+    width, height, groups = parse_font(data)
+    total_size = 4
+    print("extern const uint8_t %s_rle[] PROGMEM;" % name)
+    print("const uint8_t %s_rle[] PROGMEM =" % name)
+    print("{")
+    print("//  type|width|height|first char")
+    print("    0x%02X, 0x%02X, 0x%02X, 0x%02X," % (4, width, height, 0x00))
+    for code, glyphs in groups:
+        print("// GROUP first 0x%04X total %d chars" % (code, len(glyphs)))
+        print("//  unicode(LSB,MSB)|count")
+        print("    0x%02X, 0x%02X, 0x%02X, // unicode record" % ((code >> 8) & 0xFF, code & 0xFF, len(glyphs)))
+        packed = [ rle.compress(g[2]) for g in glyphs ]
+        offset = 0
+        for i in range(len(glyphs)):
+            print("    0x%02X, 0x%02X, 0x%02X, 0x%02X, // char 0x%04X" % \
+                  (offset >> 8, offset & 0xFF, glyphs[i][0], glyphs[i][1], code + i))
+            offset += len(packed[i])
+        print("    0x%02X, 0x%02X," % (offset >> 8, offset & 0xFF))
+        for i in range(len(glyphs)):
+            print_bytes(packed[i], "char 0x%04X" % (code + i))
+        total_size += 3 + len(glyphs) * 4 + 2 + offset
+    total_size += 3
+    print("    0x00, 0x00, 0x00, // end of unicode tables")
+    print("    // FONT REQUIRES %d BYTES, ORIGINAL FONT %d BYTES" % (total_size, len(data)))
+    print("};")
+
+def convert_bitmap(name, data):
+    packed = rle.compress(data)
+    print("extern const uint8_t %s_rle[] PROGMEM;" % name)
+    print("const uint8_t %s_rle[] PROGMEM =" % name)
+    print("{")
+    print_bytes(packed)
+    print("    // BITMAP REQUIRES %d BYTES, ORIGINAL BITMAP %d BYTES" % (len(packed), len(data)))
+    print("};")
+
+if len(sys.argv) < 4:
+    print_help_and_exit()
+
+data = read_array(sys.argv[2], sys.argv[3])
+if sys.argv[1] == "font":
+    convert_font(sys.argv[3], data)
+elif sys.argv[1] == "bitmap":
+    convert_bitmap(sys.argv[3], data)
+else:
+    print_help_and_exit()
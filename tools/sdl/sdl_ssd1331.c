@@ -38,6 +38,8 @@ static int s_pageEnd = 7;
 static int s_newColumn;
 static int s_newPage;
 static uint32_t s_color = 0;
+static uint32_t s_fillColor = 0;
+static uint8_t s_fillMode = 0;
 
 static uint8_t s_verticalMode = 1;
 static uint8_t s_leftToRight = 0;
@@ -70,6 +72,48 @@ static void copyBlock()
     }
 }
 
+static uint32_t colorComponent(int index, uint8_t data)
+{
+    switch (index)
+    {
+        case 0: // C: blue
+            return s_16bitmode ? ((data & 0x3F) >> 1) : ((data & 0x30) >> 4);
+        case 1: // B: green
+            return s_16bitmode ? ((data & 0x3F) << 5) : ((data & 0x38) >> 1);
+        default: // A: red
+            return s_16bitmode ? ((data & 0x3E) << 10) : ((data & 0x38) << 2);
+    }
+}
+
+static void fillBlock(uint32_t color)
+{
+    for (int y = s_pageStart; y <= s_pageEnd; y++)
+    {
+        for (int x = s_columnStart; x <= s_columnEnd; x++)
+        {
+            sdl_put_pixel(x, y, color);
+        }
+    }
+}
+
+static void drawRect()
+{
+    if (s_fillMode & 0x01)
+    {
+        fillBlock(s_fillColor);
+    }
+    for (int x = s_columnStart; x <= s_columnEnd; x++)
+    {
+        sdl_put_pixel(x, s_pageStart, s_color);
+        sdl_put_pixel(x, s_pageEnd, s_color);
+    }
+    for (int y = s_pageStart; y <= s_pageEnd; y++)
+    {
+        sdl_put_pixel(s_columnStart, y, s_color);
+        sdl_put_pixel(s_columnEnd, y, s_color);
+    }
+}
+
 static void drawLine()
 {
     if ( abs(s_columnStart - s_columnEnd) > abs(s_pageStart - s_pageEnd) )
@@ -92,6 +136,7 @@ static void drawLine()
             y += (s_pageEnd > s_pageStart ? 1: -1);
         }
     }
+    sdl_put_pixel(s_columnEnd, s_pageEnd, s_color);
 }
 
 static void sdl_ssd1331_reset(void)
@@ -156,22 +201,11 @@ static void sdl_ssd1331_commands(uint8_t data)
                 case 2: s_columnEnd = data; break;
                 case 3: s_pageEnd = data; break;
                 case 4:
-                    if (s_16bitmode)
-                        s_color |= ((data & 0x3F) >> 1);
-                    else
-                        s_color |= ((data & 0x30) >> 4);
-                    break;
                 case 5:
-                    if (s_16bitmode)
-                        s_color |= ((data & 0x3F) << 5);
-                    else
-                        s_color |= ((data & 0x30) >> 1);
+                    s_color |= colorComponent(s_cmdArgIndex - 4, data);
                     break;
                 case 6:
-                     if (s_16bitmode)
-                        s_color |= ((data & 0x3E) << 10);
-                     else
-                        s_color |= ((data & 0x38) << 2);
+                     s_color |= colorComponent(s_cmdArgIndex - 4, data);
                      drawLine();
                      s_commandId = SSD_COMMAND_NONE;
                      break;
@@ -179,6 +213,31 @@ static void sdl_ssd1331_commands(uint8_t data)
                      break;
             }
             break;
+        case 0x22: // DRAW RECTANGLE
+            switch (s_cmdArgIndex)
+            {
+                case 0: s_columnStart = data; s_color = 0; s_fillColor = 0; break;
+                case 1: s_pageStart = data; break;
+                case 2: s_columnEnd = data; break;
+                case 3: s_pageEnd = data; break;
+                case 4:
+                case 5:
+                case 6:
+                    s_color |= colorComponent(s_cmdArgIndex - 4, data);
+                    break;
+                case 7:
+                case 8:
+                    s_fillColor |= colorComponent(s_cmdArgIndex - 7, data);
+                    break;
+                case 9:
+                     s_fillColor |= colorComponent(s_cmdArgIndex - 7, data);
+                     drawRect();
+                     s_commandId = SSD_COMMAND_NONE;
+                     break;
+                default:
+                     break;
+            }
+            break;
         case 0x23: // MOVE BLOCK
             switch (s_cmdArgIndex)
             {
@@ -196,6 +255,28 @@ static void sdl_ssd1331_commands(uint8_t data)
                      break;
             }
             break;
+        case 0x25: // CLEAR WINDOW
+            switch (s_cmdArgIndex)
+            {
+                case 0: s_columnStart = data; break;
+                case 1: s_pageStart = data; break;
+                case 2: s_columnEnd = data; break;
+                case 3:
+                     s_pageEnd = data;
+                     fillBlock(0);
+                     s_commandId = SSD_COMMAND_NONE;
+                     break;
+                default:
+                     break;
+            }
+            break;
+        case 0x26: // FILL ENABLE / DISABLE
+            if (s_cmdArgIndex == 0)
+            {
+                s_fillMode = data;
+                s_commandId = SSD_COMMAND_NONE;
+            }
+            break;
         case 0x75:
             switch (s_cmdArgIndex)
             {